@@ -0,0 +1,90 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+
+// Many small matrices, operated on one at a time (an array of fs matrices),
+// versus all at once across the planes of an fs_matrix_batch.
+template <typename T, std::size_t N>
+void run(char const* name, std::size_t count)
+{
+    using mat = la::fs_matrix<T, N, N>;
+    using batch = la::fs_matrix_batch<T, N, N, la::aligned_allocator<T>>;
+
+    auto as = std::vector<mat>(count);
+    auto bs = std::vector<mat>(count);
+    auto a = batch(count);
+    auto b = batch(count);
+    for (auto k : la::detail::times(count))
+    {
+        for (auto [i, j] : la::detail::times(N) * la::detail::times(N))
+        {
+            as[k](i, j) = T((k + i * 7 + j * 3) % 11) - T(5) + (i == j ? T(12) : T(0));
+            bs[k](i, j) = T((k + i * 3 + j * 5) % 7) - T(3);
+        }
+        a.set(k, as[k]);
+        b.set(k, bs[k]);
+    }
+
+    // both write into preallocated results, i.e. only compute is measured
+    auto rs = std::vector<mat>(count);
+    auto r = batch(count);
+    auto const aos_mul = measure([&]() {
+        for (auto k : la::detail::times(count))
+            rs[k] = as[k] * bs[k];
+        do_not_optimize(rs[0](0, 0));
+    });
+    auto const soa_mul = measure([&]() {
+        la::multiply_into(a, b, r);
+        do_not_optimize(r(0, 0, 0));
+    });
+
+    auto const aos_inv = measure([&]() {
+        for (auto k : la::detail::times(count))
+            rs[k] = la::inverse(as[k]);
+        do_not_optimize(rs[0](0, 0));
+    });
+    auto const soa_inv = measure([&]() {
+        la::inverse_into(a, r);
+        do_not_optimize(r(0, 0, 0));
+    });
+
+    auto const m = double(count) * 1e-6;
+    std::printf("%-10s %9.1f %9.1f %6.1fx %9.1f %9.1f %6.1fx\n", name,
+                m / aos_mul, m / soa_mul, aos_mul / soa_mul,
+                m / aos_inv, m / soa_inv, aos_inv / soa_inv);
+}
+
+int main(int argc, char const* argv[])
+{
+    std::printf("%-10s %9s %9s %7s %9s %9s %7s   (M/s, isa: %s)\n", "size",
+                "mul", "batched", "", "inverse", "batched", "", la::detail::simd::isa_name);
+
+    for (auto const count : problem_sizes(argc, argv, {1 << 10, 1 << 14}))
+    {
+        run<double, 2>("2x2 double", count);
+        run<float, 3>("3x3 float", count);
+        run<double, 3>("3x3 double", count);
+        run<float, 4>("4x4 float", count);
+        run<double, 4>("4x4 double", count);
+    }
+
+    return EXIT_SUCCESS;
+}
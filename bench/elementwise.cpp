@@ -0,0 +1,53 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <cstdio>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+
+using dmat = la::dyn_matrix<double>;
+
+// The per-element loop that the arithmetic traits used before the flat SIMD kernels.
+dmat naive_subtract(dmat const& b, dmat const& ax)
+{
+    using la::detail::times;
+
+    dmat r(b.rows(), b.columns());
+    for (auto [i, j] : times(r.rows()) * times(r.columns()))
+        r(i, j) = b(i, j) - ax(i, j);
+    return r;
+}
+
+int main(int argc, char const* argv[])
+{
+    std::printf("%6s %14s %14s %9s   (isa: %s)\n", "n", "naive GB/s", "simd GB/s", "speedup", la::detail::simd::isa_name);
+
+    for (auto const n : problem_sizes(argc, argv, {64, 256, 1024, 2048}))
+    {
+        auto const b = dmat(n, n, [](auto i, auto j) { return double((i * 7 + j * 3) % 11) - 5.0; });
+        auto const ax = dmat(n, n, [](auto i, auto j) { return double((i * 5 + j * 13) % 9) - 4.0; });
+        // two reads and one write per element
+        auto const bytes = 3.0 * double(n) * double(n) * sizeof(double);
+
+        auto const naive = measure([&]() { do_not_optimize(naive_subtract(b, ax)(0, 0)); });
+        auto const simd = measure([&]() { do_not_optimize((b - ax)(0, 0)); });
+
+        std::printf("%6zu %14.2f %14.2f %8.1fx\n", n, bytes / naive * 1e-9, bytes / simd * 1e-9, naive / simd);
+    }
+
+    return EXIT_SUCCESS;
+}
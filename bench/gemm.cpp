@@ -0,0 +1,60 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <cstdio>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+
+using dmat = la::dyn_matrix<double>;
+
+// The element-wise reduction that matrix_multiplication_traits used before the GEMM kernel.
+dmat naive_multiply(dmat const& m1, dmat const& m2)
+{
+    using la::detail::times;
+    using la::detail::reduce;
+
+    dmat r(m1.rows(), m2.columns());
+    for (auto [i, j] : times(r.rows()) * times(r.columns()))
+        r(i, j) = reduce(times(m1.columns()), 0.0, [&, i = i, j = j](auto acc, auto k) {
+            return acc + m1(i, k) * m2(k, j);
+        });
+    return r;
+}
+
+int main(int argc, char const* argv[])
+{
+    std::printf("%6s %14s %14s %9s %14s %14s %14s (%zu threads)\n", "n", "naive GFLOP/s", "gemm GFLOP/s", "speedup",
+                "par GFLOP/s", "A^T*B GFLOP/s", "A*B^T GFLOP/s", la::detail::thread_pool::global().size());
+
+    for (auto const n : problem_sizes(argc, argv, {64, 128, 256, 512, 1024}))
+    {
+        auto const a = dmat(n, n, [](auto i, auto j) { return double((i * 7 + j * 3) % 11) - 5.0; });
+        auto const b = dmat(n, n, [](auto i, auto j) { return double((i * 5 + j * 13) % 9) - 4.0; });
+        auto const flops = 2.0 * double(n) * double(n) * double(n);
+
+        auto const naive = measure([&]() { do_not_optimize(naive_multiply(a, b)(0, 0)); }, 1, 0.2);
+        auto const gemm = measure([&]() { do_not_optimize((a * b)(0, 0)); });
+        auto const par = measure([&]() { do_not_optimize(la::multiply(la::execution::par, a, b)(0, 0)); });
+        auto const tn = measure([&]() { do_not_optimize((a.t() * b)(0, 0)); });
+        auto const nt = measure([&]() { do_not_optimize((a * b.t())(0, 0)); });
+
+        std::printf("%6zu %14.2f %14.2f %8.1fx %14.2f %14.2f %14.2f\n", n, flops / naive * 1e-9, flops / gemm * 1e-9,
+                    naive / gemm, flops / par * 1e-9, flops / tn * 1e-9, flops / nt * 1e-9);
+    }
+
+    return EXIT_SUCCESS;
+}
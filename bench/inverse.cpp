@@ -0,0 +1,76 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+
+// Inverses of 4x4 rigid transforms: the scalar closed form (as used for all 4x4 matrices before),
+// inverse() (SSE for floats), and the structure-aware inverse_affine() and inverse_rigid().
+template <typename T>
+void run(char const* name, std::size_t count)
+{
+    using mat = la::fs_matrix<T, 4, 4>;
+
+    auto ms = std::vector<mat>(count);
+    for (auto k : la::detail::times(count))
+    {
+        // rotation about z, then about x, and a translation
+        auto const a = T(0.001) * T(k);
+        auto const b = T(0.002) * T(k);
+        auto const ca = std::cos(a), sa = std::sin(a);
+        auto const cb = std::cos(b), sb = std::sin(b);
+        ms[k] = mat{ca,      -sa,      T(0),  T(k % 7),
+                    cb * sa, cb * ca, -sb,    T(k % 5),
+                    sb * sa, sb * ca,  cb,    T(k % 3),
+                    T(0),    T(0),     T(0),  T(1)};
+    }
+
+    auto rs = std::vector<mat>(count);
+    auto const bench = [&](auto const& invert) {
+        return measure([&]() {
+            for (auto k : la::detail::times(count))
+                rs[k] = invert(ms[k]);
+            do_not_optimize(rs[0](0, 0));
+        });
+    };
+
+    auto const closed_form = bench([](mat const& m) { return la::detail::closed_form_inverse<4, T>(m); });
+    auto const general = bench([](mat const& m) { return la::inverse(m); });
+    auto const affine = bench([](mat const& m) { return la::inverse_affine(m); });
+    auto const rigid = bench([](mat const& m) { return la::inverse_rigid(m); });
+
+    auto const m = double(count) * 1e-6;
+    std::printf("%-10s %12.1f %12.1f %12.1f %12.1f\n", name,
+                m / closed_form, m / general, m / affine, m / rigid);
+}
+
+int main(int argc, char const* argv[])
+{
+    std::printf("%-10s %12s %12s %12s %12s   (M/s, isa: %s)\n", "size",
+                "closed form", "inverse", "affine", "rigid", la::detail::simd::isa_name);
+
+    for (auto const count : problem_sizes(argc, argv, {1 << 12}))
+    {
+        run<float>("4x4 float", count);
+        run<double>("4x4 double", count);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,78 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+
+// The product loop that the multiplication traits used for fixed-size matrices before unrolling.
+template <typename T, std::size_t N>
+la::fs_matrix<T, N, N> naive_multiply(la::fs_matrix<T, N, N> const& a, la::fs_matrix<T, N, N> const& b)
+{
+    using la::detail::times;
+    using la::detail::reduce;
+
+    la::fs_matrix<T, N, N> r;
+    for (auto [i, j] : times(N) * times(N))
+        r(i, j) = reduce(times(N), T{}, [&, i = i, j = j](auto acc, auto k) { return acc + a(i, k) * b(k, j); });
+    return r;
+}
+
+template <typename T, std::size_t N>
+void run(char const* name, std::size_t count)
+{
+    using mat = la::fs_matrix<T, N, N>;
+
+    auto as = std::vector<mat>(count);
+    for (auto n : la::detail::times(count))
+        for (auto [i, j] : la::detail::times(N) * la::detail::times(N))
+            as[n](i, j) = T((n + i * 7 + j * 3) % 11) - T(5);
+
+    // chained products, as when composing transformations
+    auto const naive = measure([&]() {
+        auto p = as[0];
+        for (auto const& a : as)
+            p = naive_multiply(p, a) * T(0.25);
+        do_not_optimize(p(0, 0));
+    });
+    auto const unrolled = measure([&]() {
+        auto p = as[0];
+        for (auto const& a : as)
+            p = p * a * T(0.25);
+        do_not_optimize(p(0, 0));
+    });
+
+    auto const products = double(count) * 1e-6;
+    std::printf("%-10s %16.1f %16.1f %8.1fx\n", name, products / naive, products / unrolled, naive / unrolled);
+}
+
+int main(int argc, char const* argv[])
+{
+    std::printf("%-10s %16s %16s %9s   (isa: %s)\n", "size", "naive Mprod/s", "unrolled Mprod/s", "speedup", la::detail::simd::isa_name);
+
+    for (auto const count : problem_sizes(argc, argv, {1 << 16}))
+    {
+        run<double, 3>("3x3 double", count);
+        run<float, 3>("3x3 float", count);
+        run<double, 4>("4x4 double", count);
+        run<float, 4>("4x4 float", count);
+        run<double, 8>("8x8 double", count);
+    }
+
+    return EXIT_SUCCESS;
+}
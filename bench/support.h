@@ -0,0 +1,63 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+/// Runs the given callable at least @p minRuns times and for at least @p minSeconds,
+/// and returns the fastest observed run in seconds.
+template <typename Callable>
+double measure(Callable&& callable, int minRuns = 3, double minSeconds = 0.5)
+{
+    using clock = std::chrono::steady_clock;
+
+    double best = 1e300;
+    double total = 0;
+    for (int run = 0; run < minRuns || total < minSeconds; ++run)
+    {
+        auto const start = clock::now();
+        callable();
+        auto const seconds = std::chrono::duration<double>(clock::now() - start).count();
+        best = std::min(best, seconds);
+        total += seconds;
+    }
+    return best;
+}
+
+/// Parses the command line arguments as a list of problem sizes, or returns the defaults if none given.
+inline std::vector<std::size_t> problem_sizes(int argc, char const* argv[], std::vector<std::size_t> defaults)
+{
+    if (argc <= 1)
+        return defaults;
+
+    std::vector<std::size_t> sizes;
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(static_cast<std::size_t>(std::strtoul(argv[i], nullptr, 10)));
+    return sizes;
+}
+
+/// Prevents the compiler from optimizing away the computation of the given value.
+template <typename T>
+inline void do_not_optimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static T volatile sink;
+    sink = value;
+#endif
+}
@@ -0,0 +1,96 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+
+using vec3 = la::fs_vector<float, 3>;
+using vec4 = la::fs_vector<float, 4>;
+
+// A point cloud transformed by one 4x4 matrix: point by point through the matrix-vector product,
+// versus streamed through transform_points() in AoS and SoA layouts.
+void run(std::size_t count)
+{
+    auto const m = la::fs_matrix<float, 4, 4>{0.8f, -0.6f, 0.0f,  1.0f,
+                                              0.6f,  0.8f, 0.0f, -2.0f,
+                                              0.0f,  0.0f, 1.0f,  0.5f,
+                                              0.0f,  0.0f, 0.1f,  1.0f};
+
+    auto points = std::vector<vec3>(count);
+    auto soa = std::vector<float>(3 * count);
+    for (auto k : la::detail::times(count))
+        for (auto j : la::detail::times(std::size_t{3}))
+        {
+            points[k](j) = float((k * 7 + j * 3) % 101) * 0.01f;
+            soa[j * count + k] = points[k](j);
+        }
+
+    auto out = std::vector<vec3>(count);
+    auto soa_out = std::vector<float>(3 * count);
+    auto const in_soa = la::matrix_span<float const>(soa.data(), count, 3, 1, count);
+    auto const out_soa = la::matrix_span<float>(soa_out.data(), count, 3, 1, count);
+
+    for (auto const affine : {false, true})
+    {
+        auto const naive = measure([&]() {
+            for (auto k : la::detail::times(count))
+            {
+                auto const q = m * vec4{points[k](0), points[k](1), points[k](2), 1.0f};
+                out[k] = affine ? vec3{q(0), q(1), q(2)} : vec3{q(0) / q(3), q(1) / q(3), q(2) / q(3)};
+            }
+            do_not_optimize(out[0](0));
+        });
+        auto const aos = measure([&]() {
+            if (affine)
+                la::transform_points(m, points, out, la::affine);
+            else
+                la::transform_points(m, points, out);
+            do_not_optimize(out[0](0));
+        });
+        auto const aos_par = measure([&]() {
+            if (affine)
+                la::transform_points(la::execution::par, m, points, out, la::affine);
+            else
+                la::transform_points(la::execution::par, m, points, out);
+            do_not_optimize(out[0](0));
+        });
+        auto const soa_time = measure([&]() {
+            if (affine)
+                la::transform_points(m, in_soa, out_soa, la::affine);
+            else
+                la::transform_points(m, in_soa, out_soa);
+            do_not_optimize(soa_out[0]);
+        });
+
+        auto const mp = double(count) * 1e-6;
+        std::printf("%9zu %-10s %12.1f %12.1f %12.1f %12.1f\n", count, affine ? "affine" : "projective",
+                    mp / naive, mp / aos, mp / aos_par, mp / soa_time);
+    }
+}
+
+int main(int argc, char const* argv[])
+{
+    std::printf("%9s %-10s %12s %12s %12s %12s   (Mpoints/s, isa: %s)\n", "points", "transform",
+                "m * v", "AoS", "AoS par", "SoA", la::detail::simd::isa_name);
+
+    for (auto const count : problem_sizes(argc, argv, {1 << 12, 1 << 20}))
+        run(count);
+
+    return EXIT_SUCCESS;
+}
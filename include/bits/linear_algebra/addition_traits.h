@@ -15,6 +15,9 @@
 #pragma once
 
 #include "base.h"
+#include "execution.h"
+#include "simd.h"
+#include "unrolled_kernel.h"
 #include "operation_traits_selector.h"
 #include "dr_matrix_engine.h"
 #include "fs_matrix_engine.h"
@@ -41,37 +44,40 @@ struct matrix_addition_engine_traits // | 4.8.2
 };
 
 // (fs_matrix_engine + fs_matrix_engine)
-template <typename OT, typename T1, std::size_t R1, std::size_t C1, typename T2, std::size_t R2, std::size_t C2>
+//
+// EXT: the results of these promotions are stored in the layout of the left operand.
+template <typename OT, typename T1, std::size_t R1, std::size_t C1, typename L1,
+          typename T2, std::size_t R2, std::size_t C2, typename L2>
 struct matrix_addition_engine_traits<OT,
-                                     fs_matrix_engine<T1, R1, C1>,
-                                     fs_matrix_engine<T2, R2, C2>>
+                                     fs_matrix_engine<T1, R1, C1, L1>,
+                                     fs_matrix_engine<T2, R2, C2, L2>>
 {
     static_assert(R1 == R2);
     static_assert(C1 == C2);
     using element_type = matrix_addition_element_t<OT, T1, T2>;
-    using engine_type = fs_matrix_engine<element_type, R1, C1>;
+    using engine_type = fs_matrix_engine<element_type, R1, C1, L1>;
 };
 
 // (fs_matrix_engine + dr_matrix_engine)
-template <typename OT, typename T1, std::size_t R1, std::size_t C1, typename T2,
-    template <typename> class Allocator>
+template <typename OT, typename T1, std::size_t R1, std::size_t C1, typename L1, typename T2,
+    template <typename> class Allocator, typename L2>
 struct matrix_addition_engine_traits<OT,
-                                     fs_matrix_engine<T1, R1, C1>,
-                                     dr_matrix_engine<T2, Allocator<T2>>>
+                                     fs_matrix_engine<T1, R1, C1, L1>,
+                                     dr_matrix_engine<T2, Allocator<T2>, L2>>
 {
     using element_type = matrix_addition_element_t<OT, T1, T2>;
-    using engine_type = dr_matrix_engine<element_type, std::allocator<element_type>>;
+    using engine_type = dr_matrix_engine<element_type, std::allocator<element_type>, L1>;
 };
 
 // (dr_matrix_engine + fs_matrix_engine)
-template <typename OT, typename T1, typename T2, std::size_t R2, std::size_t C2,
+template <typename OT, typename T1, typename L1, typename T2, std::size_t R2, std::size_t C2, typename L2,
          template<typename> class Allocator>
 struct matrix_addition_engine_traits<OT,
-                                     dr_matrix_engine<T1, Allocator<T1>>,
-                                     fs_matrix_engine<T2, R2, C2>>
+                                     dr_matrix_engine<T1, Allocator<T1>, L1>,
+                                     fs_matrix_engine<T2, R2, C2, L2>>
 {
     using element_type = matrix_addition_element_t<OT, T1, T2>;
-    using engine_type = dr_matrix_engine<element_type, Allocator<element_type>>;
+    using engine_type = dr_matrix_engine<element_type, Allocator<element_type>, L1>;
 };
 
 // TODO: (transpose_engine + other)
@@ -96,13 +102,30 @@ struct matrix_addition_traits<OT, vector<ET1, OT1>, vector<ET2, OT2>>
     using result_type = vector<engine_type, op_traits>;
     constexpr static result_type add(vector<ET1, OT1> const& v1, vector<ET2, OT2> const& v2)
     {
-        result_type v3{};
-
-        if constexpr (is_resizable_engine_v<engine_type>)
-            v3.resize(v1.size());
+        return add(execution_policy_t<OT>{}, v1, v2);
+    }
 
-        for (std::size_t i = 0; i < v1.size(); ++i)
-            v3(i) = v1(i) + v2(i);
+    template <class ExecutionPolicy>
+    constexpr static result_type add(ExecutionPolicy policy, vector<ET1, OT1> const& v1, vector<ET2, OT2> const& v2)
+    {
+        auto v3 = detail::make_uninitialized<result_type>(v1.size());
+
+        if constexpr (detail::is_flat_compatible_v<engine_type, ET1, ET2>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const r = v3.span();
+                auto const a = v1.span();
+                auto const b = v2.span();
+                auto const kernel = [](auto p, std::size_t n, auto* x, auto const* y, auto const* z) {
+                    detail::simd::add(p, n, y, z, x);
+                };
+                if (detail::for_each_run(policy, kernel, r, a, b))
+                    return v3;
+            }
+        }
+
+        detail::for_each(policy, detail::times(v1.size()), [&](auto i) { v3(i) = v1(i) + v2(i); });
 
         return v3;
     }
@@ -116,15 +139,39 @@ struct matrix_addition_traits<OT, matrix<ET1, OT1>, matrix<ET2, OT2>>
     using result_type = matrix<engine_type, op_traits>;
     constexpr static result_type add(matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
     {
-        using size_type = std::size_t;
-        result_type m{};
-
-        if constexpr (is_resizable_engine_v<engine_type>)
-            m.resize(m1.rows(), m1.columns());
+        return add(execution_policy_t<OT>{}, m1, m2);
+    }
 
-        for (size_type i = 0; i < m1.rows(); ++i)
-            for (size_type j = 0; j < m1.columns(); ++j)
-                m(i, j) = m1(i, j) + m2(i, j);
+    template <class ExecutionPolicy>
+    constexpr static result_type add(ExecutionPolicy policy, matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
+    {
+        auto m = detail::make_uninitialized<result_type>(m1.rows(), m1.columns());
+
+        if constexpr (detail::is_unrollable_v<engine_type, ET1, ET2>)
+        {
+            detail::unrolled_assign(m, [&](auto i, auto j) { return m1(i, j) + m2(i, j); });
+            return m;
+        }
+        else if constexpr (detail::is_flat_compatible_v<engine_type, ET1, ET2>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const r = m.span();
+                auto const a = m1.span();
+                auto const b = m2.span();
+                auto const kernel = [](auto p, std::size_t n, auto* x, auto const* y, auto const* z) {
+                    detail::simd::add(p, n, y, z, x);
+                };
+                if (detail::for_each_run(policy, kernel, r, a, b))
+                    return m;
+            }
+        }
+
+        using detail::times;
+        detail::for_each(policy, times(m1.rows()) * times(m1.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
+            m(i, j) = m1(i, j) + m2(i, j);
+        });
 
         return m;
     }
@@ -0,0 +1,151 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+/**
+ * EXT: Allocator adaptor that default-initializes elements constructed without arguments,
+ * instead of value-initializing them.
+ *
+ * For arithmetic element types that leaves them indeterminate, so that e.g. std::vector::resize(n)
+ * does not write n zeros first. All other construction is forwarded to the adapted allocator A.
+ *
+ * The dynamically-resizable engines keep their elements in such a vector, so that they can be
+ * constructed uninitialized (see uninitialized_t).
+ */
+template <typename T, typename A = std::allocator<T>>
+class default_init_allocator : public A
+{
+    using traits = std::allocator_traits<A>;
+
+  public:
+    template <typename U>
+    struct rebind {
+        using other = default_init_allocator<U, typename traits::template rebind_alloc<U>>;
+    };
+
+    using A::A;
+
+    default_init_allocator() = default;
+
+    template <typename U, typename B>
+    default_init_allocator(default_init_allocator<U, B> const& other) noexcept : A(static_cast<B const&>(other)) {}
+
+    template <typename U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>)
+    {
+        ::new (static_cast<void*>(p)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        traits::construct(static_cast<A&>(*this), p, std::forward<Args>(args)...);
+    }
+};
+
+/// Size of a cache line, which is also the width of the widest SIMD registers (AVX-512).
+constexpr inline std::size_t cache_line_size = 64;
+
+/**
+ * EXT: Allocator of storage aligned to Alignment bytes, by default to cache lines.
+ *
+ * E.g. `dyn_matrix<double, aligned_allocator<double>>` with a padded leading dimension
+ * (see padded_t) starts each of its rows on a cache line of its own.
+ */
+template <typename T, std::size_t Alignment = cache_line_size>
+class aligned_allocator
+{
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two and at least the alignment of T.");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t alignment = Alignment;
+
+    template <typename U>
+    struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+    constexpr aligned_allocator() noexcept = default;
+
+    template <typename U>
+    constexpr aligned_allocator(aligned_allocator<U, Alignment> const&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    constexpr bool operator==(aligned_allocator<U, Alignment> const&) const noexcept { return true; }
+
+    template <typename U>
+    constexpr bool operator!=(aligned_allocator<U, Alignment> const&) const noexcept { return false; }
+};
+
+namespace detail {
+    /// Leading dimension (in elements) for rows of n elements of type T, such that rows start on
+    /// cache line boundaries (given aligned storage, see aligned_allocator), and their distance in
+    /// bytes is not a multiple of 512. Rows that far apart map to the same L1 cache sets (4K
+    /// aliasing), i.e. a walk down a column would evict its own cache lines after only a few rows.
+    template <typename T>
+    constexpr std::size_t padded_leading_dimension(std::size_t n) noexcept
+    {
+        if constexpr (cache_line_size % sizeof(T) != 0)
+            return n;
+        else
+        {
+            constexpr auto W = cache_line_size / sizeof(T);
+            auto ld = (n + W - 1) / W * W;
+            if (n > 1 && (ld * sizeof(T)) % 512 == 0)
+                ld += W;
+            return ld;
+        }
+    }
+
+    /// Allocator A adapted to default-initialize (see default_init_allocator), unless it already does.
+    template <typename T, typename A>
+    struct default_init_allocator_of { using type = default_init_allocator<T, A>; };
+
+    template <typename T, typename U, typename B>
+    struct default_init_allocator_of<T, default_init_allocator<U, B>> { using type = default_init_allocator<U, B>; };
+
+    template <typename T, typename A>
+    using default_init_allocator_t = typename default_init_allocator_of<T, A>::type;
+}
+
+} // end namespace
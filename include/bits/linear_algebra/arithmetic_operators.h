@@ -17,11 +17,43 @@
 #include "vector.h"
 #include "matrix.h"
 #include "operation_traits.h"
+#include "execution.h"
+#include "simd.h"
+
+#include <type_traits>
+#include <utility>
 
 // 6.10 | arithmetic operators
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
 
+//- EXT: overloads for expiring operands, e.g. (A + B) - C, which compute the result in the storage
+//  of the rvalue operand and return it, instead of allocating a new result.
+//
+namespace detail { // {{{
+    /// Tests whether the arithmetic traits are the library's own, which compute the same as the
+    /// in-place updates (+=, -=, *=) that replace them for expiring operands. Custom traits of an
+    /// operation traits type must be invoked instead, as they may compute differently.
+    template <class Traits> struct is_default_arithmetic_traits : public std::false_type {};
+    template <class OT, class OP1>
+    struct is_default_arithmetic_traits<matrix_negation_traits<OT, OP1>> : public std::true_type {};
+    template <class OT, class OP1, class OP2>
+    struct is_default_arithmetic_traits<matrix_addition_traits<OT, OP1, OP2>> : public std::true_type {};
+    template <class OT, class OP1, class OP2>
+    struct is_default_arithmetic_traits<matrix_subtraction_traits<OT, OP1, OP2>> : public std::true_type {};
+    template <class OT, class OP1, class OP2>
+    struct is_default_arithmetic_traits<matrix_multiplication_traits<OT, OP1, OP2>> : public std::true_type {};
+
+    /// Tests whether the result R of an arithmetic operation of the given Traits can reuse the
+    /// storage of its operand OP, i.e. whether the traits are the default ones (see above), and R
+    /// is of the very same (heap allocated and flat) type as OP.
+    template <class Traits, class R, class OP>
+    constexpr inline bool is_reusable_operand_v = is_default_arithmetic_traits<Traits>::value
+                                               && std::is_same_v<std::decay_t<R>, OP>
+                                               && is_resizable_engine_v<typename OP::engine_type>
+                                               && has_writable_span<typename OP::engine_type>::value;
+} // }}}
+
 //- Negation
 //
 template <class ET1, class OT1>
@@ -34,6 +66,21 @@ constexpr operator-(vector<ET1, OT1> const& v1)
     return neg_traits::negate(v1);
 }
 
+template <class ET1, class OT1>
+inline auto
+constexpr operator-(vector<ET1, OT1>&& v1)
+{
+    using op1_type = vector<ET1, OT1>;
+    using neg_traits = matrix_negation_traits_t<OT1, op1_type>;
+    if constexpr (detail::is_reusable_operand_v<neg_traits, decltype(neg_traits::negate(v1)), op1_type>)
+    {
+        detail::negate_in_place(execution_policy_t<OT1>{}, v1);
+        return std::move(v1);
+    }
+    else
+        return neg_traits::negate(v1);
+}
+
 template <class ET1, class OT1>
 inline auto
 constexpr operator-(matrix<ET1, OT1> const& m1)
@@ -44,6 +91,21 @@ constexpr operator-(matrix<ET1, OT1> const& m1)
     return neg_traits::negate(m1);
 }
 
+template <class ET1, class OT1>
+inline auto
+constexpr operator-(matrix<ET1, OT1>&& m1)
+{
+    using op1_type = matrix<ET1, OT1>;
+    using neg_traits = matrix_negation_traits_t<OT1, op1_type>;
+    if constexpr (detail::is_reusable_operand_v<neg_traits, decltype(neg_traits::negate(m1)), op1_type>)
+    {
+        detail::negate_in_place(execution_policy_t<OT1>{}, m1);
+        return std::move(m1);
+    }
+    else
+        return neg_traits::negate(m1);
+}
+
 //- Addition
 //
 template <class ET1, class OT1, class ET2, class OT2>
@@ -57,6 +119,51 @@ constexpr operator+(vector<ET1, OT1> const& v1, vector<ET2, OT2> const& v2)
     return add_traits::add(v1, v2);
 }
 
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator+(vector<ET1, OT1>&& v1, vector<ET2, OT2> const& v2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = vector<ET1, OT1>;
+    using op2_type = vector<ET2, OT2>;
+    using add_traits = matrix_addition_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<add_traits, decltype(add_traits::add(v1, v2)), op1_type>)
+        return std::move(v1 += v2);
+    else
+        return add_traits::add(v1, v2);
+}
+
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator+(vector<ET1, OT1> const& v1, vector<ET2, OT2>&& v2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = vector<ET1, OT1>;
+    using op2_type = vector<ET2, OT2>;
+    using add_traits = matrix_addition_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<add_traits, decltype(add_traits::add(v1, v2)), op2_type>)
+    {
+        v2 += v1;
+        return std::move(v2);
+    }
+    else
+        return add_traits::add(v1, v2);
+}
+
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator+(vector<ET1, OT1>&& v1, vector<ET2, OT2>&& v2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = vector<ET1, OT1>;
+    using op2_type = vector<ET2, OT2>;
+    using add_traits = matrix_addition_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<add_traits, decltype(add_traits::add(v1, v2)), op1_type>)
+        return std::move(v1 += v2);
+    else
+        return std::as_const(v1) + std::move(v2);
+}
+
 template <class ET1, class OT1, class ET2, class OT2>
 inline auto
 constexpr operator+(matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
@@ -71,6 +178,51 @@ constexpr operator+(matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
     return add_traits::add(m1, m2);
 }
 
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator+(matrix<ET1, OT1>&& m1, matrix<ET2, OT2> const& m2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = matrix<ET1, OT1>;
+    using op2_type = matrix<ET2, OT2>;
+    using add_traits = matrix_addition_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<add_traits, decltype(add_traits::add(m1, m2)), op1_type>)
+        return std::move(m1 += m2);
+    else
+        return add_traits::add(m1, m2);
+}
+
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator+(matrix<ET1, OT1> const& m1, matrix<ET2, OT2>&& m2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = matrix<ET1, OT1>;
+    using op2_type = matrix<ET2, OT2>;
+    using add_traits = matrix_addition_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<add_traits, decltype(add_traits::add(m1, m2)), op2_type>)
+    {
+        m2 += m1;
+        return std::move(m2);
+    }
+    else
+        return add_traits::add(m1, m2);
+}
+
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator+(matrix<ET1, OT1>&& m1, matrix<ET2, OT2>&& m2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = matrix<ET1, OT1>;
+    using op2_type = matrix<ET2, OT2>;
+    using add_traits = matrix_addition_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<add_traits, decltype(add_traits::add(m1, m2)), op1_type>)
+        return std::move(m1 += m2);
+    else
+        return std::as_const(m1) + std::move(m2);
+}
+
 //- Subtraction
 //
 template <class ET1, class OT1, class ET2, class OT2>
@@ -84,6 +236,51 @@ constexpr operator-(vector<ET1, OT1> const& v1, vector<ET2, OT2> const& v2)
     return sub_traits::subtract(v1, v2);
 }
 
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator-(vector<ET1, OT1>&& v1, vector<ET2, OT2> const& v2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = vector<ET1, OT1>;
+    using op2_type = vector<ET2, OT2>;
+    using sub_traits = matrix_subtraction_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<sub_traits, decltype(sub_traits::subtract(v1, v2)), op1_type>)
+        return std::move(v1 -= v2);
+    else
+        return sub_traits::subtract(v1, v2);
+}
+
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator-(vector<ET1, OT1> const& v1, vector<ET2, OT2>&& v2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = vector<ET1, OT1>;
+    using op2_type = vector<ET2, OT2>;
+    using sub_traits = matrix_subtraction_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<sub_traits, decltype(sub_traits::subtract(v1, v2)), op2_type>)
+    {
+        detail::subtract_from(execution_policy_t<op_traits>{}, v1, v2);
+        return std::move(v2);
+    }
+    else
+        return sub_traits::subtract(v1, v2);
+}
+
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator-(vector<ET1, OT1>&& v1, vector<ET2, OT2>&& v2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = vector<ET1, OT1>;
+    using op2_type = vector<ET2, OT2>;
+    using sub_traits = matrix_subtraction_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<sub_traits, decltype(sub_traits::subtract(v1, v2)), op1_type>)
+        return std::move(v1 -= v2);
+    else
+        return std::as_const(v1) - std::move(v2);
+}
+
 template <class ET1, class OT1, class ET2, class OT2>
 inline auto
 constexpr operator-(matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
@@ -95,6 +292,51 @@ constexpr operator-(matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
     return sub_traits::subtract(m1, m2);
 }
 
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator-(matrix<ET1, OT1>&& m1, matrix<ET2, OT2> const& m2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = matrix<ET1, OT1>;
+    using op2_type = matrix<ET2, OT2>;
+    using sub_traits = matrix_subtraction_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<sub_traits, decltype(sub_traits::subtract(m1, m2)), op1_type>)
+        return std::move(m1 -= m2);
+    else
+        return sub_traits::subtract(m1, m2);
+}
+
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator-(matrix<ET1, OT1> const& m1, matrix<ET2, OT2>&& m2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = matrix<ET1, OT1>;
+    using op2_type = matrix<ET2, OT2>;
+    using sub_traits = matrix_subtraction_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<sub_traits, decltype(sub_traits::subtract(m1, m2)), op2_type>)
+    {
+        detail::subtract_from(execution_policy_t<op_traits>{}, m1, m2);
+        return std::move(m2);
+    }
+    else
+        return sub_traits::subtract(m1, m2);
+}
+
+template <class ET1, class OT1, class ET2, class OT2>
+inline auto
+constexpr operator-(matrix<ET1, OT1>&& m1, matrix<ET2, OT2>&& m2)
+{
+    using op_traits = matrix_operation_traits_selector_t<OT1, OT2>;
+    using op1_type = matrix<ET1, OT1>;
+    using op2_type = matrix<ET2, OT2>;
+    using sub_traits = matrix_subtraction_traits_t<op_traits, op1_type, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<sub_traits, decltype(sub_traits::subtract(m1, m2)), op1_type>)
+        return std::move(m1 -= m2);
+    else
+        return std::as_const(m1) - std::move(m2);
+}
+
 //- Multiplication
 //- vector*scalar and scalar*vector
 //
@@ -122,6 +364,30 @@ constexpr operator*(S1 const& s1, vector<ET2, OT2> const& v2)
     return mul_traits::multiply(s1, v2);
 }
 
+template <class ET1, class OT1, class S2, std::enable_if_t<is_matrix_element_v<S2>, int> = 0>
+inline auto
+constexpr operator*(vector<ET1, OT1>&& v1, S2 const& s2)
+{
+    using op1_type = vector<ET1, OT1>;
+    using mul_traits = matrix_multiplication_traits_t<OT1, op1_type, S2>;
+    if constexpr (detail::is_reusable_operand_v<mul_traits, decltype(mul_traits::multiply(v1, s2)), op1_type>)
+        return std::move(v1 *= s2);
+    else
+        return mul_traits::multiply(v1, s2);
+}
+
+template <class S1, class ET2, class OT2, std::enable_if_t<is_matrix_element_v<S1>, int> = 0>
+inline auto
+constexpr operator*(S1 const& s1, vector<ET2, OT2>&& v2)
+{
+    using op2_type = vector<ET2, OT2>;
+    using mul_traits = matrix_multiplication_traits_t<OT2, S1, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<mul_traits, decltype(mul_traits::multiply(s1, v2)), op2_type>)
+        return std::move(v2 *= s1);
+    else
+        return mul_traits::multiply(s1, v2);
+}
+
 // matrix*scalar and scalar*matrix
 template <class ET1, class OT1, class S2>
 inline auto
@@ -147,6 +413,30 @@ constexpr operator*(S1 const& s1, matrix<ET2, OT2> const& m2)
     return mul_traits::multiply(s1, m2);
 }
 
+template <class ET1, class OT1, class S2, std::enable_if_t<is_matrix_element_v<S2>, int> = 0>
+inline auto
+constexpr operator*(matrix<ET1, OT1>&& m1, S2 const& s2)
+{
+    using op1_type = matrix<ET1, OT1>;
+    using mul_traits = matrix_multiplication_traits_t<OT1, op1_type, S2>;
+    if constexpr (detail::is_reusable_operand_v<mul_traits, decltype(mul_traits::multiply(m1, s2)), op1_type>)
+        return std::move(m1 *= s2);
+    else
+        return mul_traits::multiply(m1, s2);
+}
+
+template <class S1, class ET2, class OT2, std::enable_if_t<is_matrix_element_v<S1>, int> = 0>
+inline auto
+constexpr operator*(S1 const& s1, matrix<ET2, OT2>&& m2)
+{
+    using op2_type = matrix<ET2, OT2>;
+    using mul_traits = matrix_multiplication_traits_t<OT2, S1, op2_type>;
+    if constexpr (detail::is_reusable_operand_v<mul_traits, decltype(mul_traits::multiply(s1, m2)), op2_type>)
+        return std::move(m2 *= s1);
+    else
+        return mul_traits::multiply(s1, m2);
+}
+
 // vector*vector
 template <class ET1, class OT1, class ET2, class OT2>
 inline auto
@@ -195,4 +485,55 @@ constexpr operator*(matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
     return mul_traits::multiply(m1, m2);
 }
 
+//- EXT: arithmetic operations with an explicit execution policy, e.g. multiply(execution::par, A, B).
+//
+namespace detail { // {{{
+    template <class OP> struct arithmetic_op_traits { using type = void; }; // scalar operand
+    template <class ET, class OT> struct arithmetic_op_traits<vector<ET, OT>> { using type = OT; };
+    template <class ET, class OT> struct arithmetic_op_traits<matrix<ET, OT>> { using type = OT; };
+
+    template <class OP1, class OP2, class OT1 = typename arithmetic_op_traits<OP1>::type,
+                                    class OT2 = typename arithmetic_op_traits<OP2>::type>
+    struct binary_op_traits { using type = matrix_operation_traits_selector_t<OT1, OT2>; };
+    template <class OP1, class OP2, class OT1>
+    struct binary_op_traits<OP1, OP2, OT1, void> { using type = OT1; };
+    template <class OP1, class OP2, class OT2>
+    struct binary_op_traits<OP1, OP2, void, OT2> { using type = OT2; };
+
+    template <class OP1, class OP2>
+    using binary_op_traits_t = typename binary_op_traits<OP1, OP2>::type;
+} // }}}
+
+template <class ExecutionPolicy, class OP1, std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+constexpr auto negate(ExecutionPolicy&& policy, OP1 const& op1)
+{
+    using op_traits = typename detail::arithmetic_op_traits<OP1>::type;
+    using neg_traits = matrix_negation_traits_t<op_traits, OP1>;
+    return neg_traits::negate(policy, op1);
+}
+
+template <class ExecutionPolicy, class OP1, class OP2, std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+constexpr auto add(ExecutionPolicy&& policy, OP1 const& op1, OP2 const& op2)
+{
+    using op_traits = detail::binary_op_traits_t<OP1, OP2>;
+    using add_traits = matrix_addition_traits_t<op_traits, OP1, OP2>;
+    return add_traits::add(policy, op1, op2);
+}
+
+template <class ExecutionPolicy, class OP1, class OP2, std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+constexpr auto subtract(ExecutionPolicy&& policy, OP1 const& op1, OP2 const& op2)
+{
+    using op_traits = detail::binary_op_traits_t<OP1, OP2>;
+    using sub_traits = matrix_subtraction_traits_t<op_traits, OP1, OP2>;
+    return sub_traits::subtract(policy, op1, op2);
+}
+
+template <class ExecutionPolicy, class OP1, class OP2, std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+constexpr auto multiply(ExecutionPolicy&& policy, OP1 const& op1, OP2 const& op2)
+{
+    using op_traits = detail::binary_op_traits_t<OP1, OP2>;
+    using mul_traits = matrix_multiplication_traits_t<op_traits, OP1, OP2>;
+    return mul_traits::multiply(policy, op1, op2);
+}
+
 } // end namespace
@@ -0,0 +1,407 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+#include "execution.h"
+#include "simd.h"
+#include "span.h"
+#include "support.h"
+#include "transpose_engine.h"
+#include "transpose_kernel.h"
+
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+// ---------------------------------------------------------------------------
+// EXT | arithmetic assignment traits for +=, -=, *= (scalar) and /= (scalar)
+//
+// Unlike the arithmetic traits, these update their left hand side in place, i.e. there is no engine
+// promotion, and no allocation. Thus they also apply to writable views (rows, columns, submatrices
+// and transposes) of a matrix.
+
+namespace detail { // {{{
+    /// a = op(a, b) over two vector spans of the same size, if both are contiguous.
+    template <typename T, typename U, typename ExecutionPolicy, typename Op>
+    bool update_elementwise(ExecutionPolicy policy, vector_span<T> a, vector_span<U> b, Op op)
+    {
+        return for_each_run(policy, [&](auto p, std::size_t n, T* x, U* y) { simd::transform(p, n, x, y, x, op); }, a, b);
+    }
+
+    /// a = op(a, b) over two matrix spans of the same shape, row by row (or column by column)
+    /// if they share their layout.
+    ///
+    /// b may view the storage of a itself in transposed layout (e.g. m += m.t()), in which case
+    /// it is copied to a temporary first, as a would otherwise be read after being updated.
+    template <typename T, typename U, typename ExecutionPolicy, typename Op>
+    bool update_elementwise(ExecutionPolicy policy, matrix_span<T> a, matrix_span<U> b, Op op)
+    {
+        assert(a.rows() == b.rows() && a.columns() == b.columns());
+
+        if (a.data() == b.data() && (a.row_stride() != b.row_stride() || a.column_stride() != b.column_stride())
+            && a.rows() * a.columns() > 1)
+        {
+            auto const m = a.rows();
+            auto const n = a.columns();
+            auto tmp = std::vector<T>(m * n);
+            auto const t = a.is_row_major() ? matrix_span<T const>(tmp.data(), m, n, n, 1)
+                                            : matrix_span<T const>(tmp.data(), m, n, 1, m);
+            copy_blocked(m, n, b.data(), b.row_stride(), b.column_stride(),
+                         tmp.data(), t.row_stride(), t.column_stride());
+            return update_elementwise(policy, a, t, op);
+        }
+
+        return for_each_run(policy, [&](auto p, std::size_t n, T* x, U* y) { simd::transform(p, n, x, y, x, op); }, a, b);
+    }
+
+    /// Tests whether one of m1 and m2 is a transpose view of the other (e.g. m += m.t()), in which
+    /// case m1 must not be updated element by element, as some of its elements would be read back
+    /// through m2 after their update. Unlike update_elementwise(), this compares the engines, and
+    /// thus also holds for elements without SIMD kernels and in constant evaluation.
+    template <class ET1, class OT1, class ET2, class OT2>
+    constexpr bool is_transposed_alias(matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
+    {
+        if constexpr (is_transpose_of_v<ET2, ET1>)
+            return m1.rows() > 1 && m2.engine().viewed_engine() == &m1.engine();
+        else if constexpr (is_transpose_of_v<ET1, ET2>)
+            return m1.rows() > 1 && m1.engine().viewed_engine() == &m2.engine();
+        else
+            return false;
+    }
+
+    /// Copy of m2, in an owning engine, for reading it while updating m1, see is_transposed_alias().
+    template <class ET1, class OT1, class ET2, class OT2>
+    constexpr auto evaluate_alias(matrix<ET1, OT1> const&, matrix<ET2, OT2> const& m2)
+    {
+        using engine_type = std::conditional_t<is_transpose_of_v<ET2, ET1>, transposed_engine_t<ET1>, ET2>;
+        return matrix<engine_type, OT2>(m2);
+    }
+
+    /// Tests whether engine ET can be updated in place by the SIMD kernels with scalars of type S.
+    template <typename ET, typename S>
+    constexpr inline bool is_flat_scalable_v = is_flat_compatible_v<ET> && std::is_same_v<S, typename ET::value_type>;
+
+    /// v = -v
+    template <class ExecutionPolicy, class ET, class OT>
+    constexpr void negate_in_place(ExecutionPolicy policy, vector<ET, OT>& v)
+    {
+        if constexpr (is_flat_compatible_v<ET>)
+            if (!is_constant_evaluated()
+                && for_each_run(policy, [](auto p, std::size_t n, auto* a) { simd::negate(p, n, a, a); }, v.span()))
+                return;
+
+        for_each(policy, times(v.size()), [&](auto i) { v(i) = -v(i); });
+    }
+
+    /// m = -m
+    template <class ExecutionPolicy, class ET, class OT>
+    constexpr void negate_in_place(ExecutionPolicy policy, matrix<ET, OT>& m)
+    {
+        if constexpr (is_flat_compatible_v<ET>)
+            if (!is_constant_evaluated()
+                && for_each_run(policy, [](auto p, std::size_t n, auto* a) { simd::negate(p, n, a, a); }, m.span()))
+                return;
+
+        for_each(policy, times(m.rows()) * times(m.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
+            m(i, j) = -m(i, j);
+        });
+    }
+
+    /// v2 = v1 - v2, i.e. the subtraction updating its right hand side in place.
+    template <class ExecutionPolicy, class ET1, class OT1, class ET2, class OT2>
+    constexpr void subtract_from(ExecutionPolicy policy, vector<ET1, OT1> const& v1, vector<ET2, OT2>& v2)
+    {
+        assert(v1.size() == v2.size());
+
+        if constexpr (is_flat_compatible_v<ET2, ET1>)
+            if (!is_constant_evaluated() && update_elementwise(policy, v2.span(), v1.span(), simd::reverse_minus_op{}))
+                return;
+
+        for_each(policy, times(v2.size()), [&](auto i) { v2(i) = v1(i) - v2(i); });
+    }
+
+    /// m2 = m1 - m2, i.e. the subtraction updating its right hand side in place.
+    template <class ExecutionPolicy, class ET1, class OT1, class ET2, class OT2>
+    constexpr void subtract_from(ExecutionPolicy policy, matrix<ET1, OT1> const& m1, matrix<ET2, OT2>& m2)
+    {
+        assert(m1.size() == m2.size());
+
+        if (is_transposed_alias(m2, m1))
+            return subtract_from(policy, evaluate_alias(m2, m1), m2);
+
+        if constexpr (is_flat_compatible_v<ET2, ET1>)
+            if (!is_constant_evaluated() && update_elementwise(policy, m2.span(), m1.span(), simd::reverse_minus_op{}))
+                return;
+
+        for_each(policy, times(m2.rows()) * times(m2.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
+            m2(i, j) = m1(i, j) - m2(i, j);
+        });
+    }
+} // }}}
+
+// ---------------------------------------------------------------------------
+// matrix_addition_assignment_traits<OT, OP1, OP2>
+
+template <class OT, class OP1, class OP2> struct matrix_addition_assignment_traits;
+
+template <class OT, class ET1, class OT1, class ET2, class OT2>
+struct matrix_addition_assignment_traits<OT, vector<ET1, OT1>, vector<ET2, OT2>>
+{
+    using op_traits = OT;
+    using result_type = vector<ET1, OT1>&;
+    constexpr static result_type add_assign(vector<ET1, OT1>& v1, vector<ET2, OT2> const& v2)
+    {
+        return add_assign(execution_policy_t<OT>{}, v1, v2);
+    }
+
+    template <class ExecutionPolicy>
+    constexpr static result_type add_assign(ExecutionPolicy policy, vector<ET1, OT1>& v1, vector<ET2, OT2> const& v2)
+    {
+        assert(v1.size() == v2.size());
+
+        if constexpr (detail::is_flat_compatible_v<ET1, ET2>)
+            if (!detail::is_constant_evaluated() && detail::update_elementwise(policy, v1.span(), v2.span(), detail::simd::plus_op{}))
+                return v1;
+
+        detail::for_each(policy, detail::times(v1.size()), [&](auto i) { v1(i) = v1(i) + v2(i); });
+        return v1;
+    }
+};
+
+template <class OT, class ET1, class OT1, class ET2, class OT2>
+struct matrix_addition_assignment_traits<OT, matrix<ET1, OT1>, matrix<ET2, OT2>>
+{
+    using op_traits = OT;
+    using result_type = matrix<ET1, OT1>&;
+    constexpr static result_type add_assign(matrix<ET1, OT1>& m1, matrix<ET2, OT2> const& m2)
+    {
+        return add_assign(execution_policy_t<OT>{}, m1, m2);
+    }
+
+    template <class ExecutionPolicy>
+    constexpr static result_type add_assign(ExecutionPolicy policy, matrix<ET1, OT1>& m1, matrix<ET2, OT2> const& m2)
+    {
+        assert(m1.size() == m2.size());
+
+        if (detail::is_transposed_alias(m1, m2))
+        {
+            auto const t = detail::evaluate_alias(m1, m2);
+            return matrix_addition_assignment_traits<OT, matrix<ET1, OT1>, std::decay_t<decltype(t)>>::add_assign(policy, m1, t);
+        }
+
+        if constexpr (detail::is_flat_compatible_v<ET1, ET2>)
+            if (!detail::is_constant_evaluated() && detail::update_elementwise(policy, m1.span(), m2.span(), detail::simd::plus_op{}))
+                return m1;
+
+        using detail::times;
+        detail::for_each(policy, times(m1.rows()) * times(m1.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
+            m1(i, j) = m1(i, j) + m2(i, j);
+        });
+        return m1;
+    }
+};
+
+template <class OT, class OP1, class OP2>
+using matrix_addition_assignment_traits_t = typename OT::template addition_assignment_traits<OT, OP1, OP2>;
+
+// ---------------------------------------------------------------------------
+// matrix_subtraction_assignment_traits<OT, OP1, OP2>
+
+template <class OT, class OP1, class OP2> struct matrix_subtraction_assignment_traits;
+
+template <class OT, class ET1, class OT1, class ET2, class OT2>
+struct matrix_subtraction_assignment_traits<OT, vector<ET1, OT1>, vector<ET2, OT2>>
+{
+    using op_traits = OT;
+    using result_type = vector<ET1, OT1>&;
+    constexpr static result_type subtract_assign(vector<ET1, OT1>& v1, vector<ET2, OT2> const& v2)
+    {
+        return subtract_assign(execution_policy_t<OT>{}, v1, v2);
+    }
+
+    template <class ExecutionPolicy>
+    constexpr static result_type subtract_assign(ExecutionPolicy policy, vector<ET1, OT1>& v1, vector<ET2, OT2> const& v2)
+    {
+        assert(v1.size() == v2.size());
+
+        if constexpr (detail::is_flat_compatible_v<ET1, ET2>)
+            if (!detail::is_constant_evaluated() && detail::update_elementwise(policy, v1.span(), v2.span(), detail::simd::minus_op{}))
+                return v1;
+
+        detail::for_each(policy, detail::times(v1.size()), [&](auto i) { v1(i) = v1(i) - v2(i); });
+        return v1;
+    }
+};
+
+template <class OT, class ET1, class OT1, class ET2, class OT2>
+struct matrix_subtraction_assignment_traits<OT, matrix<ET1, OT1>, matrix<ET2, OT2>>
+{
+    using op_traits = OT;
+    using result_type = matrix<ET1, OT1>&;
+    constexpr static result_type subtract_assign(matrix<ET1, OT1>& m1, matrix<ET2, OT2> const& m2)
+    {
+        return subtract_assign(execution_policy_t<OT>{}, m1, m2);
+    }
+
+    template <class ExecutionPolicy>
+    constexpr static result_type subtract_assign(ExecutionPolicy policy, matrix<ET1, OT1>& m1, matrix<ET2, OT2> const& m2)
+    {
+        assert(m1.size() == m2.size());
+
+        if (detail::is_transposed_alias(m1, m2))
+        {
+            auto const t = detail::evaluate_alias(m1, m2);
+            return matrix_subtraction_assignment_traits<OT, matrix<ET1, OT1>, std::decay_t<decltype(t)>>::subtract_assign(policy, m1, t);
+        }
+
+        if constexpr (detail::is_flat_compatible_v<ET1, ET2>)
+            if (!detail::is_constant_evaluated() && detail::update_elementwise(policy, m1.span(), m2.span(), detail::simd::minus_op{}))
+                return m1;
+
+        using detail::times;
+        detail::for_each(policy, times(m1.rows()) * times(m1.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
+            m1(i, j) = m1(i, j) - m2(i, j);
+        });
+        return m1;
+    }
+};
+
+template <class OT, class OP1, class OP2>
+using matrix_subtraction_assignment_traits_t = typename OT::template subtraction_assignment_traits<OT, OP1, OP2>;
+
+// ---------------------------------------------------------------------------
+// matrix_multiplication_assignment_traits<OT, OP1, S2>, multiplication by a scalar
+
+template <class OT, class OP1, class S2> struct matrix_multiplication_assignment_traits;
+
+template <class OT, class ET1, class OT1, class S2>
+struct matrix_multiplication_assignment_traits<OT, vector<ET1, OT1>, S2>
+{
+    using op_traits = OT;
+    using result_type = vector<ET1, OT1>&;
+    constexpr static result_type multiply_assign(vector<ET1, OT1>& v1, S2 const& s2)
+    {
+        return multiply_assign(execution_policy_t<OT>{}, v1, s2);
+    }
+
+    template <class ExecutionPolicy>
+    constexpr static result_type multiply_assign(ExecutionPolicy policy, vector<ET1, OT1>& v1, S2 const& s2)
+    {
+        if constexpr (detail::is_flat_scalable_v<ET1, S2>)
+            if (!detail::is_constant_evaluated()
+                && detail::for_each_run(policy, [&](auto p, std::size_t n, S2* a) { detail::simd::scale(p, n, a, s2, a); }, v1.span()))
+                return v1;
+
+        detail::for_each(policy, detail::times(v1.size()), [&](auto i) { v1(i) = v1(i) * s2; });
+        return v1;
+    }
+};
+
+template <class OT, class ET1, class OT1, class S2>
+struct matrix_multiplication_assignment_traits<OT, matrix<ET1, OT1>, S2>
+{
+    using op_traits = OT;
+    using result_type = matrix<ET1, OT1>&;
+    constexpr static result_type multiply_assign(matrix<ET1, OT1>& m1, S2 const& s2)
+    {
+        return multiply_assign(execution_policy_t<OT>{}, m1, s2);
+    }
+
+    template <class ExecutionPolicy>
+    constexpr static result_type multiply_assign(ExecutionPolicy policy, matrix<ET1, OT1>& m1, S2 const& s2)
+    {
+        if constexpr (detail::is_flat_scalable_v<ET1, S2>)
+            if (!detail::is_constant_evaluated()
+                && detail::for_each_run(policy, [&](auto p, std::size_t n, S2* a) { detail::simd::scale(p, n, a, s2, a); }, m1.span()))
+                return m1;
+
+        using detail::times;
+        detail::for_each(policy, times(m1.rows()) * times(m1.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
+            m1(i, j) = m1(i, j) * s2;
+        });
+        return m1;
+    }
+};
+
+template <class OT, class OP1, class S2>
+using matrix_multiplication_assignment_traits_t = typename OT::template multiplication_assignment_traits<OT, OP1, S2>;
+
+// ---------------------------------------------------------------------------
+// matrix_division_assignment_traits<OT, OP1, S2>, division by a scalar
+
+template <class OT, class OP1, class S2> struct matrix_division_assignment_traits;
+
+template <class OT, class ET1, class OT1, class S2>
+struct matrix_division_assignment_traits<OT, vector<ET1, OT1>, S2>
+{
+    using op_traits = OT;
+    using result_type = vector<ET1, OT1>&;
+    constexpr static result_type divide_assign(vector<ET1, OT1>& v1, S2 const& s2)
+    {
+        return divide_assign(execution_policy_t<OT>{}, v1, s2);
+    }
+
+    template <class ExecutionPolicy>
+    constexpr static result_type divide_assign(ExecutionPolicy policy, vector<ET1, OT1>& v1, S2 const& s2)
+    {
+        if constexpr (detail::is_flat_scalable_v<ET1, S2>)
+            if (!detail::is_constant_evaluated()
+                && detail::for_each_run(policy, [&](auto p, std::size_t n, S2* a) { detail::simd::divide(p, n, a, s2, a); }, v1.span()))
+                return v1;
+
+        detail::for_each(policy, detail::times(v1.size()), [&](auto i) { v1(i) = v1(i) / s2; });
+        return v1;
+    }
+};
+
+template <class OT, class ET1, class OT1, class S2>
+struct matrix_division_assignment_traits<OT, matrix<ET1, OT1>, S2>
+{
+    using op_traits = OT;
+    using result_type = matrix<ET1, OT1>&;
+    constexpr static result_type divide_assign(matrix<ET1, OT1>& m1, S2 const& s2)
+    {
+        return divide_assign(execution_policy_t<OT>{}, m1, s2);
+    }
+
+    template <class ExecutionPolicy>
+    constexpr static result_type divide_assign(ExecutionPolicy policy, matrix<ET1, OT1>& m1, S2 const& s2)
+    {
+        if constexpr (detail::is_flat_scalable_v<ET1, S2>)
+            if (!detail::is_constant_evaluated()
+                && detail::for_each_run(policy, [&](auto p, std::size_t n, S2* a) { detail::simd::divide(p, n, a, s2, a); }, m1.span()))
+                return m1;
+
+        using detail::times;
+        detail::for_each(policy, times(m1.rows()) * times(m1.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
+            m1(i, j) = m1(i, j) / s2;
+        });
+        return m1;
+    }
+};
+
+template <class OT, class OP1, class S2>
+using matrix_division_assignment_traits_t = typename OT::template division_assignment_traits<OT, OP1, S2>;
+
+} // end namespace
@@ -45,16 +45,54 @@ struct readable_matrix_engine_tag {};   // i.e. matrix read-only
 struct writable_matrix_engine_tag {};   // i.e. matrix read-write fixed-size
 struct resizable_matrix_engine_tag {};  // i.e. matrix read-write resizable
 
+//- EXT: Tag for constructing an owning engine (or a matrix or vector thereof) whose elements are
+//  left default-initialized, i.e. indeterminate for arithmetic types, as they are about to be
+//  overwritten anyway. E.g. `dyn_matrix<double> m(uninitialized, rows, cols)`.
+//
+struct uninitialized_t { explicit uninitialized_t() = default; };
+constexpr inline uninitialized_t uninitialized{};
+
+//- EXT: Tag for constructing a dynamically-resizable matrix engine whose leading dimension is
+//  padded to whole cache lines, avoiding power-of-two strides (see padded_leading_dimension()).
+//  E.g. `dyn_matrix<double, aligned_allocator<double>> m(padded, rows, cols)`.
+//
+struct padded_t { explicit padded_t() = default; };
+constexpr inline padded_t padded{};
+
+//- EXT: Storage orders (layouts) of the owning dense matrix engines, i.e. whether the elements
+//  of a row (row_major) or of a column (column_major) are adjacent in memory.
+//  E.g. `matrix<dr_matrix_engine<double, std::allocator<double>, column_major>>`.
+//
+struct row_major {};
+struct column_major {};
+
+template <typename L> constexpr inline bool is_matrix_layout_v =
+    std::is_same_v<L, row_major> || std::is_same_v<L, column_major>;
+
+namespace detail {
+    /// The other layout, i.e. the one in which the storage of a matrix denotes its transpose.
+    template <typename L> using transposed_layout_t =
+        std::conditional_t<std::is_same_v<L, row_major>, column_major, row_major>;
+}
+
+//- Tags that describe lazily evaluated expressions (EXT, see expression.h).
+//
+struct vector_expression_tag {};
+struct matrix_expression_tag {};
+
 // Trivial engine that represents the scalar operand.
 template <typename T> struct scalar_engine;
 
 // Owning fixed-size engines.
 template <typename T, size_t N> class fs_vector_engine;
-template <typename T, size_t R, size_t C> class fs_matrix_engine;
+template <typename T, size_t R, size_t C, typename L = row_major> class fs_matrix_engine;
 
 // Owning engines with dynamically-allocated external storage.
 template <typename T, typename AT = std::allocator<T>> class dr_vector_engine;
-template <typename T, typename AT = std::allocator<T>> class dr_matrix_engine;
+template <typename T, typename AT = std::allocator<T>, typename L = row_major> class dr_matrix_engine;
+
+// EXT: owning sparse engines (see csr_matrix_engine.h).
+template <typename T, typename AT = std::allocator<T>> class csr_matrix_engine;
 
 // Non-owning engines.
 template <typename ET, typename VCT, typename VFT> class vector_view_engine;
@@ -116,6 +154,48 @@ template <typename ET> constexpr inline bool is_vector_engine_v =
 
 template <typename ET> constexpr inline bool is_engine_v = is_matrix_engine_v<ET> || is_vector_engine_v<ET>;
 
+namespace detail {
+    /// Constructs the result R of an operation that overwrites all of its elements, of the given
+    /// size (if resizable), without initializing its elements first where the engine supports that.
+    template <typename R, typename... Sizes>
+    constexpr R make_uninitialized(Sizes... sizes)
+    {
+        using ET = typename R::engine_type;
+        if constexpr (is_resizable_engine_v<ET>)
+        {
+            if constexpr (std::is_constructible_v<ET, uninitialized_t, Sizes...>)
+                return R(uninitialized, sizes...);
+            else
+            {
+                R r;
+                r.resize(sizes...);
+                return r;
+            }
+        }
+        else if constexpr (std::is_constructible_v<ET, uninitialized_t>)
+            return R(uninitialized);
+        else
+            return R{};
+    }
+}
+
+namespace detail {
+    template <typename X, typename = void> struct expression_category_of { using type = void; };
+    template <typename X> struct expression_category_of<X, std::void_t<typename X::expression_category>> {
+        using type = typename X::expression_category;
+    };
+}
+
+// EXT: tests whether X is a lazily evaluated (matrix or vector) expression.
+template <typename X> constexpr inline bool is_expression_v =
+    !std::is_void_v<typename detail::expression_category_of<X>::type>;
+
+template <typename X> constexpr inline bool is_matrix_expression_v =
+    std::is_same_v<typename detail::expression_category_of<X>::type, matrix_expression_tag>;
+
+template <typename X> constexpr inline bool is_vector_expression_v =
+    std::is_same_v<typename detail::expression_category_of<X>::type, vector_expression_tag>;
+
 template <typename ET> struct is_submatrix_engine : public std::false_type {};
 // template <typename E, typename MCT>
 //     struct is_submatrix_engine<matrix_view_engine<E, MCT, submatrix_view_tag>>
@@ -130,6 +210,11 @@ template <typename ET> struct is_submatrix_engine : public std::false_type {};
 template <typename ET> constexpr inline bool is_submatrix_engine_v = is_submatrix_engine<ET>::value;
 // TODO: rename to is_fs_submatrix_engine_v
 
+// EXT: tests whether ET is a csr_matrix_engine, for which the arithmetic traits use sparse kernels.
+template <typename ET> struct is_csr_matrix_engine : public std::false_type {};
+template <typename T, typename AT> struct is_csr_matrix_engine<csr_matrix_engine<T, AT>> : public std::true_type {};
+template <typename ET> constexpr inline bool is_csr_matrix_engine_v = is_csr_matrix_engine<ET>::value;
+
 template <typename VCT> constexpr inline bool is_vector_engine_tag =
     std::is_same_v<VCT, readable_vector_engine_tag> ||
     std::is_same_v<VCT, writable_vector_engine_tag> ||
@@ -141,13 +226,13 @@ template <typename T> constexpr inline bool is_matrix_element_v =
 
 // EXT: row_count_v<ET> evaluates to the number of rows of the given engine.
 template <typename ET> struct row_count;
-template <typename T, size_t R, size_t C> struct row_count<fs_matrix_engine<T, R, C>> { static constexpr size_t value = R; };
+template <typename T, size_t R, size_t C, typename L> struct row_count<fs_matrix_engine<T, R, C, L>> { static constexpr size_t value = R; };
 template <typename T, size_t N> struct row_count<fs_vector_engine<T, N>> { static constexpr size_t value = N; };
 template <typename ET> constexpr inline size_t row_count_v = row_count<ET>::value;
 
 // EXT: column_count_v<ET> evaluates to the number of columns of the given engine.
 template <typename ET> struct column_count;
-template <typename T, size_t R, size_t C> struct column_count<fs_matrix_engine<T, R, C>> { static constexpr size_t value = R; };
+template <typename T, size_t R, size_t C, typename L> struct column_count<fs_matrix_engine<T, R, C, L>> { static constexpr size_t value = C; };
 template <typename T, size_t N> struct column_count<fs_vector_engine<T, N>> { static constexpr size_t value = N; };
 template <typename ET> constexpr inline size_t column_count_v = column_count<ET>::value;
 
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "base.h"
+#include "csr_matrix_engine.h"
 #include "dr_vector_engine.h"
 #include "dr_matrix_engine.h"
 #include "fs_vector_engine.h"
@@ -26,13 +27,16 @@ namespace LINEAR_ALGEBRA_NAMESPACE {
 template <class T, class AT = std::allocator<T>>
 using dyn_vector = vector<dr_vector_engine<T, AT>, matrix_operation_traits>;
 
+template <class T, class AT = std::allocator<T>, class L = row_major>
+using dyn_matrix = matrix<dr_matrix_engine<T, AT, L>, matrix_operation_traits>;
+
 template <class T, class AT = std::allocator<T>>
-using dyn_matrix = matrix<dr_matrix_engine<T, AT>, matrix_operation_traits>;
+using csr_matrix = matrix<csr_matrix_engine<T, AT>, matrix_operation_traits>;
 
 template <class T, int32_t N>
 using fs_vector = vector<fs_vector_engine<T, N>, matrix_operation_traits>;
 
-template <class T, int32_t R, int32_t C>
-using fs_matrix = matrix<fs_matrix_engine<T, R, C>, matrix_operation_traits>;
+template <class T, int32_t R, int32_t C, class L = row_major>
+using fs_matrix = matrix<fs_matrix_engine<T, R, C, L>, matrix_operation_traits>;
 
 } // end namespace
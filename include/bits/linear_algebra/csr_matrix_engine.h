@@ -0,0 +1,311 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+namespace detail { // {{{
+    /// Proxy reference to an element of a sparse matrix engine, which inserts the element on assignment.
+    template <typename ET>
+    class sparse_reference {
+      public:
+        using size_type = typename ET::size_type;
+        using value_type = typename ET::value_type;
+
+        sparse_reference(ET& _engine, size_type _i, size_type _j) noexcept : engine_{_engine}, i_{_i}, j_{_j} {}
+
+        sparse_reference& operator=(value_type const& _value)
+        {
+            engine_.assign(i_, j_, _value);
+            return *this;
+        }
+
+        sparse_reference& operator=(sparse_reference const& _other) { return *this = value_type(_other); }
+
+        operator value_type() const { return std::as_const(engine_)(i_, j_); }
+
+      private:
+        ET& engine_;
+        size_type i_;
+        size_type j_;
+    };
+} // }}}
+
+/**
+ * EXT: Sparse matrix engine in compressed sparse row (CSR) format.
+ *
+ * The non-zero elements are stored row by row, ordered by column, in values(), with their column
+ * indices in column_indices(). The elements of row i are at the positions [row_offsets()[i],
+ * row_offsets()[i + 1]).
+ *
+ * Reading an element is a binary search within its row, i.e. O(log nnz(row)). Assigning a
+ * non-zero to a position not stored yet has to shift all elements behind it and is thus only
+ * cheap when appending in row-major order; bulk data should be passed to the constructor taking
+ * the three CSR arrays instead.
+ */
+template <class T, class AT>
+class csr_matrix_engine : public matrix_engine<csr_matrix_engine<T, AT>>
+{
+  public:
+    //- Types
+    //
+    using engine_category = resizable_matrix_engine_tag;
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using allocator_type = AT;
+    using pointer = typename std::allocator_traits<AT>::pointer;
+    using const_pointer = typename std::allocator_traits<AT>::const_pointer;
+    using reference = detail::sparse_reference<csr_matrix_engine>;
+    using const_reference = element_type const&;
+    using difference_type = std::ptrdiff_t;
+    using size_type = std::size_t;
+    using size_tuple = std::tuple<size_type, size_type>;
+    using index_allocator_type = typename std::allocator_traits<AT>::template rebind_alloc<size_type>;
+    using index_vector = std::vector<size_type, index_allocator_type>;
+    using value_vector = std::vector<value_type, AT>;
+
+    //- Construct/copy/destroy
+    //
+    ~csr_matrix_engine() noexcept = default;
+    csr_matrix_engine() = default;
+    csr_matrix_engine(csr_matrix_engine&&) noexcept = default;
+    csr_matrix_engine(csr_matrix_engine const&) = default;
+    csr_matrix_engine(size_type rows, size_type cols) : row_offsets_(rows + 1), rows_{rows}, columns_{cols} {}
+
+    /// Constructs the engine from its three CSR arrays, taking ownership of them.
+    ///
+    /// Column indices must be sorted ascending, and unique, within each row.
+    csr_matrix_engine(size_type rows, size_type cols,
+                      index_vector row_offsets, index_vector column_indices, value_vector values) :
+        row_offsets_{std::move(row_offsets)},
+        column_indices_{std::move(column_indices)},
+        values_{std::move(values)},
+        rows_{rows},
+        columns_{cols}
+    {
+        assert(row_offsets_.size() == rows + 1);
+        assert(row_offsets_.front() == 0 && row_offsets_.back() == values_.size());
+        assert(column_indices_.size() == values_.size());
+    }
+
+    csr_matrix_engine& operator=(csr_matrix_engine&&) noexcept = default;
+    csr_matrix_engine& operator=(csr_matrix_engine const&) = default;
+
+    template <class ET2>
+    csr_matrix_engine& operator=(ET2 const& rhs)
+    {
+        csr_matrix_engine clone(rhs.rows(), rhs.columns());
+        for (size_type i = 0; i < rhs.rows(); ++i)
+        {
+            for (size_type j = 0; j < rhs.columns(); ++j)
+                if (auto const v = value_type(rhs(i, j)); v != value_type{})
+                {
+                    clone.column_indices_.push_back(j);
+                    clone.values_.push_back(v);
+                }
+            clone.row_offsets_[i + 1] = clone.values_.size();
+        }
+        clone.swap(*this);
+        return *this;
+    }
+
+    //- Capacity
+    //
+    size_type columns() const noexcept { return columns_; }
+    size_type rows() const noexcept { return rows_; }
+    size_tuple size() const noexcept { return {rows(), columns()}; }
+    size_type column_capacity() const noexcept { return columns_; }
+    size_type row_capacity() const noexcept { return rows_; }
+    size_tuple capacity() const noexcept { return {row_capacity(), column_capacity()}; }
+
+    /// Number of stored (structurally non-zero) elements.
+    size_type nonzeros() const noexcept { return values_.size(); }
+
+    /// Dense capacities do not apply to sparse storage, see reserve_nonzeros() instead.
+    void reserve(size_type /*rowcap*/, size_type /*colcap*/) {}
+
+    void reserve_nonzeros(size_type n)
+    {
+        column_indices_.reserve(n);
+        values_.reserve(n);
+    }
+
+    /// Resizes the matrix, dropping all stored elements outside of the new bounds.
+    void resize(size_type rows, size_type cols)
+    {
+        if (rows < rows_ || cols < columns_)
+        {
+            size_type k = 0;
+            for (size_type i = 0; i < std::min(rows, rows_); ++i)
+            {
+                auto const end = row_offsets_[i + 1];
+                for (auto p = row_offsets_[i]; p < end; ++p)
+                    if (column_indices_[p] < cols)
+                    {
+                        column_indices_[k] = column_indices_[p];
+                        values_[k] = std::move(values_[p]);
+                        ++k;
+                    }
+                row_offsets_[i + 1] = k;
+            }
+            column_indices_.resize(k);
+            values_.resize(k, value_type{});
+        }
+
+        row_offsets_.resize(rows + 1, values_.size());
+        rows_ = rows;
+        columns_ = cols;
+    }
+
+    void resize(size_type rows, size_type cols, size_type /*rowcap*/, size_type /*colcap*/)
+    {
+        resize(rows, cols);
+    }
+
+    //- Element access
+    //
+    reference operator()(size_type i, size_type j) { return reference(*this, i, j); }
+
+    const_reference operator()(size_type i, size_type j) const
+    {
+        static value_type const zero{};
+        auto const p = find(i, j);
+        return p != npos ? values_[p] : zero;
+    }
+
+    /// Assigns value v to the element at (i, j), inserting it if not stored yet and v is non-zero.
+    void assign(size_type i, size_type j, value_type const& v)
+    {
+        assert(i < rows() && j < columns());
+
+        auto const first = column_indices_.begin() + difference_type(row_offsets_[i]);
+        auto const last = column_indices_.begin() + difference_type(row_offsets_[i + 1]);
+        auto const it = std::lower_bound(first, last, j);
+        auto const p = size_type(it - column_indices_.begin());
+
+        if (it != last && *it == j)
+            values_[p] = v;
+        else if (v != value_type{})
+        {
+            column_indices_.insert(it, j);
+            values_.insert(values_.begin() + difference_type(p), v);
+            for (auto k = i + 1; k <= rows(); ++k)
+                ++row_offsets_[k];
+        }
+    }
+
+    //- Raw storage access
+    //
+    index_vector const& row_offsets() const noexcept { return row_offsets_; }
+    index_vector const& column_indices() const noexcept { return column_indices_; }
+    value_vector const& values() const noexcept { return values_; }
+    value_vector& values() noexcept { return values_; }
+
+    //- Modifiers
+    //
+    void swap(csr_matrix_engine& other) noexcept
+    {
+        std::swap(row_offsets_, other.row_offsets_);
+        std::swap(column_indices_, other.column_indices_);
+        std::swap(values_, other.values_);
+        std::swap(rows_, other.rows_);
+        std::swap(columns_, other.columns_);
+    }
+
+    void swap_columns(size_type c1, size_type c2)
+    {
+        if (c1 == c2)
+            return;
+
+        for (size_type i = 0; i < rows(); ++i)
+        {
+            auto const first = row_offsets_[i];
+            auto const last = row_offsets_[i + 1];
+            auto changed = false;
+            for (auto p = first; p < last; ++p)
+                if (column_indices_[p] == c1 || column_indices_[p] == c2)
+                {
+                    column_indices_[p] = column_indices_[p] == c1 ? c2 : c1;
+                    changed = true;
+                }
+
+            // restore the column order within the row (insertion sort, as only two elements moved)
+            if (changed)
+                for (auto p = first + 1; p < last; ++p)
+                    for (auto q = p; q > first && column_indices_[q - 1] > column_indices_[q]; --q)
+                    {
+                        std::swap(column_indices_[q - 1], column_indices_[q]);
+                        std::swap(values_[q - 1], values_[q]);
+                    }
+        }
+    }
+
+    void swap_rows(size_type r1, size_type r2)
+    {
+        if (r1 == r2)
+            return;
+        if (r2 < r1)
+            std::swap(r1, r2);
+
+        // Rotate the storage [begin(r1), end(r2)) so that row r2 comes first and row r1 last.
+        auto const b1 = row_offsets_[r1];
+        auto const e1 = row_offsets_[r1 + 1];
+        auto const b2 = row_offsets_[r2];
+        auto const e2 = row_offsets_[r2 + 1];
+        auto const n1 = e1 - b1;
+        auto const n2 = e2 - b2;
+
+        auto const rotate = [&](auto& v) {
+            auto const at = [&](size_type k) { return v.begin() + difference_type(k); };
+            std::rotate(at(b1), at(b2), at(e2));            // [r2 | r1 | between]
+            std::rotate(at(b1 + n2), at(b1 + n2 + n1), at(e2)); // [r2 | between | r1]
+        };
+        rotate(column_indices_);
+        rotate(values_);
+
+        auto const delta = difference_type(n2) - difference_type(n1);
+        for (auto k = r1 + 1; k <= r2; ++k)
+            row_offsets_[k] = size_type(difference_type(row_offsets_[k]) + delta);
+    }
+
+  private:
+    constexpr static size_type npos = size_type(-1);
+
+    size_type find(size_type i, size_type j) const noexcept
+    {
+        auto const first = column_indices_.begin() + difference_type(row_offsets_[i]);
+        auto const last = column_indices_.begin() + difference_type(row_offsets_[i + 1]);
+        auto const it = std::lower_bound(first, last, j);
+        return it != last && *it == j ? size_type(it - column_indices_.begin()) : npos;
+    }
+
+    index_vector row_offsets_ = index_vector(1);
+    index_vector column_indices_;
+    value_vector values_;
+    size_type rows_ = 0;
+    size_type columns_ = 0;
+};
+
+} // end namespace
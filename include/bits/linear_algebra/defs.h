@@ -16,3 +16,13 @@
 
 #define LINEAR_ALGEBRA_NAMESPACE math
 #define LA_EXT 1
+
+// The uninitialized_t constructors of the fixed-size engines leave their storage uninitialized,
+// because every element is written right after (e.g. by make_uninitialized() in the arithmetic
+// traits) and zeroing it first is a measurable cost for small matrices. A constexpr constructor
+// may only skip a member's initialization since C++20 (P1331), before that it is value-initialized.
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201907L
+#define LA_UNINITIALIZED_MEMBER(member)
+#else
+#define LA_UNINITIALIZED_MEMBER(member) : member{}
+#endif
@@ -14,23 +14,35 @@
 
 #pragma once
 
+#include "allocator.h"
 #include "base.h"
+#include "span.h"
 
 #include <cassert>
 #include <vector>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
 
 // 6.4.2
-template<class T, class AT>
-class dr_matrix_engine: public matrix_engine<dr_matrix_engine<T, AT>>
+//
+// EXT: the elements are stored in the layout L, i.e. row_major or column_major (see base.h).
+template<class T, class AT, class L>
+class dr_matrix_engine: public matrix_engine<dr_matrix_engine<T, AT, L>>
 {
+    static_assert(is_matrix_layout_v<L>, "Layout must be row_major or column_major.");
+
+    template <class, class, class> friend class dr_matrix_engine;
+
+    static constexpr bool is_column_major = std::is_same_v<L, column_major>;
+
   public:
     //- Types
     //
     using engine_category = resizable_matrix_engine_tag;
+    using layout_type = L; // EXT
     using element_type = T;
     using value_type = std::remove_cv_t<T>;
     using allocator_type = AT;
@@ -41,6 +53,8 @@ class dr_matrix_engine: public matrix_engine<dr_matrix_engine<T, AT>>
     using difference_type = ptrdiff_t;
     using size_type = size_t;
     using size_tuple = std::tuple<size_type, size_type>;
+    using span_type = matrix_span<element_type>;
+    using const_span_type = matrix_span<element_type const>;
 
     //- Construct/copy/destroy
     //
@@ -58,8 +72,28 @@ class dr_matrix_engine: public matrix_engine<dr_matrix_engine<T, AT>>
         row_capacity_ = rowcap;
         column_capacity_ = colcap;
 
+        elements_.resize(rowcap * colcap, value_type{});
+    }
+    /// EXT: leaves all elements (including the padding) indeterminate, see uninitialized_t.
+    dr_matrix_engine(uninitialized_t, size_type rows, size_type cols) : dr_matrix_engine(uninitialized, rows, cols, rows, cols) {}
+    dr_matrix_engine(uninitialized_t, size_type rows, size_type cols, size_type rowcap, size_type colcap)
+    {
+        assert(rows <= rowcap && cols <= colcap);
+
+        rows_ = rows;
+        columns_ = cols;
+        row_capacity_ = rowcap;
+        column_capacity_ = colcap;
+
         elements_.resize(rowcap * colcap);
     }
+    /// EXT: rows of cols elements (or columns of rows elements, if column-major), padded to
+    /// detail::padded_leading_dimension<T>() elements. The padding is kept for as long as the
+    /// engine is not resized beyond its capacity.
+    dr_matrix_engine(padded_t, size_type rows, size_type cols)
+        : dr_matrix_engine(rows, cols,
+                           is_column_major ? detail::padded_leading_dimension<value_type>(rows) : rows,
+                           is_column_major ? cols : detail::padded_leading_dimension<value_type>(cols)) {}
     dr_matrix_engine& operator=(dr_matrix_engine&&) noexcept = default;
     dr_matrix_engine& operator=(dr_matrix_engine const&) = default;
     template<class ET2>
@@ -102,8 +136,42 @@ class dr_matrix_engine: public matrix_engine<dr_matrix_engine<T, AT>>
 
     //- Element access
     //
-    reference operator()(size_type i, size_type j) { return elements_[i * column_capacity() + j]; }
-    const_reference operator()(size_type i, size_type j) const { return elements_[i * column_capacity() + j]; }
+    reference operator()(size_type i, size_type j) { return elements_[offset(i, j)]; }
+    const_reference operator()(size_type i, size_type j) const { return elements_[offset(i, j)]; }
+
+    //- Data access
+    //
+    /// Storage of rows() x columns() elements, rows being column_capacity() (the leading dimension) apart,
+    /// or columns being row_capacity() apart, if column-major.
+    pointer data() noexcept { return elements_.data(); }
+    const_pointer data() const noexcept { return elements_.data(); }
+    span_type span() noexcept
+    {
+        if constexpr (is_column_major)
+            return span_type(data(), rows(), columns(), 1, row_capacity());
+        else
+            return span_type(data(), rows(), columns(), column_capacity());
+    }
+    const_span_type span() const noexcept
+    {
+        if constexpr (is_column_major)
+            return const_span_type(data(), rows(), columns(), 1, row_capacity());
+        else
+            return const_span_type(data(), rows(), columns(), column_capacity());
+    }
+
+    /// EXT: the transpose of this matrix, which takes over its storage, read in the other layout.
+    dr_matrix_engine<T, AT, detail::transposed_layout_t<L>> transposed() && noexcept
+    {
+        dr_matrix_engine<T, AT, detail::transposed_layout_t<L>> t;
+        t.elements_ = std::move(elements_);
+        t.rows_ = columns_;
+        t.columns_ = rows_;
+        t.row_capacity_ = column_capacity_;
+        t.column_capacity_ = row_capacity_;
+        rows_ = columns_ = row_capacity_ = column_capacity_ = 0;
+        return t;
+    }
 
     //- Modifiers
     //
@@ -125,7 +193,15 @@ class dr_matrix_engine: public matrix_engine<dr_matrix_engine<T, AT>>
     }
 
   private:
-    std::vector<T, AT> elements_;
+    size_type offset(size_type i, size_type j) const noexcept
+    {
+        if constexpr (is_column_major)
+            return j * row_capacity() + i;
+        else
+            return i * column_capacity() + j;
+    }
+
+    std::vector<T, detail::default_init_allocator_t<T, AT>> elements_;
     size_type row_capacity_;
     size_type column_capacity_;
     size_type rows_;
@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include "allocator.h"
 #include "base.h"
+#include "span.h"
 
 #include <algorithm>
 #include <initializer_list>
@@ -27,7 +29,8 @@ namespace LINEAR_ALGEBRA_NAMESPACE {
 template<class T, class AT>
 class dr_vector_engine {
   private:
-    std::vector<T, AT> elements_;
+    using storage_type = std::vector<T, detail::default_init_allocator_t<T, AT>>;
+    storage_type elements_;
 
   public:
     //- Types
@@ -42,8 +45,10 @@ class dr_vector_engine {
     using const_reference = element_type const&;
     using difference_type = ptrdiff_t;
     using size_type = size_t;
-    using iterator = typename std::vector<T>::iterator;
-    using const_iterator = typename std::vector<T>::const_iterator;
+    using iterator = typename storage_type::iterator;
+    using const_iterator = typename storage_type::const_iterator;
+    using span_type = vector_span<element_type>;
+    using const_span_type = vector_span<element_type const>;
 
     //- Construct/copy/destroy
     //
@@ -66,6 +71,11 @@ class dr_vector_engine {
         reserve(elem_cap);
         resize(elems);
     }
+    /// EXT: leaves all elements indeterminate, see uninitialized_t.
+    dr_vector_engine(uninitialized_t, size_type elems)
+    {
+        elements_.resize(elems);
+    }
     dr_vector_engine& operator =(dr_vector_engine&& rhs) noexcept = default;
     dr_vector_engine& operator =(dr_vector_engine const& rhs) = default;
     template<class ET2>
@@ -92,11 +102,11 @@ class dr_vector_engine {
     size_type capacity() const noexcept { return elements_.capacity(); }
     size_type elements() const noexcept { return elements_.size(); }
     void reserve(size_type cap) { elements_.reserve(cap); }
-    void resize(size_type elems) { elements_.resize(elems); }
+    void resize(size_type elems) { elements_.resize(elems, value_type{}); }
     void resize(size_type elems, size_type cap)
     {
         elements_.reserve(cap);
-        elements_.resize(elems);
+        elements_.resize(elems, value_type{});
     }
 
     //- Element access
@@ -104,6 +114,13 @@ class dr_vector_engine {
     reference operator ()(size_type i) { return elements_[i]; }
     const_reference operator ()(size_type i) const { return elements_[i]; }
 
+    //- Data access
+    //
+    pointer data() noexcept { return elements_.data(); }
+    const_pointer data() const noexcept { return elements_.data(); }
+    span_type span() noexcept { return span_type(data(), elements()); }
+    const_span_type span() const noexcept { return const_span_type(data(), elements()); }
+
     //- Modifiers
     //
     void swap(dr_vector_engine& rhs) noexcept { std::swap(elements_, rhs.elements_); }
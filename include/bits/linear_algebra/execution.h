@@ -0,0 +1,335 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "support.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__clang__)
+#define LA_PRAGMA_UNSEQ _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define LA_PRAGMA_UNSEQ _Pragma("GCC ivdep")
+#else
+#define LA_PRAGMA_UNSEQ
+#endif
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+// EXT: execution policies for the algorithms the arithmetic operation traits are built upon.
+//
+// These mirror the ones of <execution>, but come with their own (pthreads based) parallel backend,
+// as the standard library's parallel algorithms are not available on all platforms.
+namespace execution {
+    /// Sequential execution in iteration order. The default, and the only one usable in constant expressions.
+    struct sequenced_policy {};
+
+    /// Sequential execution, but with iterations that may be interleaved (vectorized) by the compiler.
+    struct unsequenced_policy {};
+
+    /// Execution in chunks on the threads of the global thread pool, with each chunk run unsequenced.
+    struct parallel_policy {};
+
+    constexpr inline sequenced_policy seq{};
+    constexpr inline unsequenced_policy unseq{};
+    constexpr inline parallel_policy par{};
+}
+
+template <typename T> struct is_execution_policy : public std::false_type {};
+template <> struct is_execution_policy<execution::sequenced_policy> : public std::true_type {};
+template <> struct is_execution_policy<execution::unsequenced_policy> : public std::true_type {};
+template <> struct is_execution_policy<execution::parallel_policy> : public std::true_type {};
+
+template <typename T> constexpr inline bool is_execution_policy_v = is_execution_policy<std::decay_t<T>>::value;
+
+namespace detail {
+    template <typename OT, typename = void> struct execution_policy_of { using type = execution::sequenced_policy; };
+    template <typename OT> struct execution_policy_of<OT, std::void_t<typename OT::execution_policy>> {
+        using type = typename OT::execution_policy;
+    };
+}
+
+/// Execution policy the arithmetic traits of the operation traits OT run with,
+/// which is OT::execution_policy if declared, and sequential otherwise.
+template <typename OT> using execution_policy_t = typename detail::execution_policy_of<OT>::type;
+
+} // end namespace
+
+namespace LINEAR_ALGEBRA_NAMESPACE::detail {
+
+/**
+ * Fixed-size pool of worker threads for fork-join style data parallelism.
+ *
+ * The calling thread takes part in the work, so that a pool of size N runs N - 1 workers.
+ * Parallel loops invoked from within a worker run sequentially rather than nesting.
+ */
+class thread_pool {
+  public:
+    explicit thread_pool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        for (std::size_t i = 1; i < threads; ++i)
+            workers_.emplace_back([this]() { work(); });
+    }
+
+    thread_pool(thread_pool const&) = delete;
+    thread_pool& operator=(thread_pool const&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            auto const _ = std::lock_guard{mutex_};
+            stopping_ = true;
+        }
+        wakeup_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    /// Number of threads work is distributed onto, including the calling thread.
+    std::size_t size() const noexcept { return workers_.size() + 1; }
+
+    /// Pool used by execution::par, sized to the number of hardware threads.
+    static thread_pool& global()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+    /**
+     * Invokes body(begin, end) for disjoint, contiguous chunks covering [0, count), and waits for all of them.
+     *
+     * @param grain minimum number of iterations per chunk, so that small loops do not pay for synchronization.
+     *
+     * If any invocation throws, the first exception is rethrown once all chunks have finished.
+     */
+    template <typename Body>
+    void parallel_for(std::size_t count, std::size_t grain, Body const& body)
+    {
+        auto const chunks = std::min(size(), count / std::max(grain, std::size_t{1}));
+        if (chunks <= 1 || is_worker())
+        {
+            body(std::size_t{0}, count);
+            return;
+        }
+
+        struct {
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::size_t pending;
+            std::exception_ptr error;
+        } join;
+        join.pending = chunks - 1;
+
+        auto const run = [&](std::size_t chunk) {
+            try
+            {
+                body(count * chunk / chunks, count * (chunk + 1) / chunks);
+            }
+            catch (...)
+            {
+                auto const _ = std::lock_guard{join.mutex};
+                if (!join.error)
+                    join.error = std::current_exception();
+            }
+        };
+
+        {
+            auto const _ = std::lock_guard{mutex_};
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+                tasks_.emplace_back([&, chunk]() {
+                    run(chunk);
+                    auto const _ = std::lock_guard{join.mutex};
+                    if (--join.pending == 0)
+                        join.finished.notify_one();
+                });
+        }
+        wakeup_.notify_all();
+
+        run(0);
+
+        auto lock = std::unique_lock{join.mutex};
+        join.finished.wait(lock, [&]() { return join.pending == 0; });
+        if (join.error)
+            std::rethrow_exception(join.error);
+    }
+
+  private:
+    static bool& is_worker() noexcept
+    {
+        thread_local bool worker = false;
+        return worker;
+    }
+
+    void work()
+    {
+        is_worker() = true;
+        for (;;)
+        {
+            auto lock = std::unique_lock{mutex_};
+            wakeup_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty())
+                return;
+            auto task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_ = false;
+};
+
+/// Minimum number of iterations a parallel loop hands to a single thread.
+constexpr inline std::size_t parallel_grain_size = 4096;
+
+// ---------------------------------------------------------------------------------------------------
+// Iteration over [begin, end) of a random-access index range, such as times(n) or times(n) * times(m).
+
+template <typename Range, typename Lambda>
+constexpr void for_each_in(Range const& _range, std::size_t _begin, std::size_t _end, Lambda& _lambda)
+{
+    LA_PRAGMA_UNSEQ
+    for (std::size_t k = _begin; k < _end; ++k)
+        _lambda(_range[k]);
+}
+
+// Two-dimensional ranges are walked row by row, rather than dividing each flat index.
+template <typename I, typename T1, typename T2, typename Lambda>
+constexpr void for_each_in(_Times2D<I, T1, T2> const& _range, std::size_t _begin, std::size_t _end, Lambda& _lambda)
+{
+    auto const columns = _range.second.size();
+    if (columns == 0)
+        return;
+
+    for (std::size_t outer = _begin / columns; _begin < _end; ++outer)
+    {
+        auto const inner = _begin % columns;
+        auto const innerEnd = std::min(columns, inner + (_end - _begin));
+        auto const i = _range.first[outer];
+        LA_PRAGMA_UNSEQ
+        for (std::size_t k = inner; k < innerEnd; ++k)
+            _lambda(std::tuple<T1, T2>{i, _range.second[k]});
+        _begin += innerEnd - inner;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------
+// Overloads of for_each and all_of (see support.h) for an execution policy, and sum() of terms,
+// whose chunks may be added up in parallel. (A general reduce() of an arbitrary binary operation
+// has no parallel overload, as the partial results could not be combined by it.)
+//
+// The policy-taking overloads require random-access ranges (size() and operator[]).
+
+template <typename Container, typename Lambda>
+constexpr void for_each(execution::sequenced_policy, Container&& _container, Lambda&& _lambda)
+{
+    for_each(std::forward<Container>(_container), std::forward<Lambda>(_lambda));
+}
+
+template <typename Container, typename Lambda>
+constexpr void for_each(execution::unsequenced_policy, Container&& _container, Lambda&& _lambda)
+{
+    for_each_in(_container, 0, _container.size(), _lambda);
+}
+
+template <typename Container, typename Lambda>
+void for_each(execution::parallel_policy, Container&& _container, Lambda&& _lambda)
+{
+    thread_pool::global().parallel_for(_container.size(), parallel_grain_size, [&](auto _begin, auto _end) {
+        for_each_in(_container, _begin, _end, _lambda);
+    });
+}
+
+/// Sum init + term(x) + ... over the elements x of the container, in order.
+template <typename Container, typename T, typename UnaryOp>
+constexpr T sum(execution::sequenced_policy, Container&& _container, T _init, UnaryOp _term)
+{
+    return reduce(std::forward<Container>(_container), std::move(_init),
+                  [&](T acc, auto const& x) { return std::move(acc) + _term(x); });
+}
+
+template <typename Container, typename T, typename UnaryOp>
+constexpr T sum(execution::unsequenced_policy, Container&& _container, T _init, UnaryOp _term)
+{
+    return sum(execution::seq, std::forward<Container>(_container), std::move(_init), std::move(_term));
+}
+
+/// Sums up each chunk on its own thread, starting from T{}, and then the chunk sums in chunk order.
+///
+/// Unlike a general reduction, the partial results are combined by +, for which T{} is the identity.
+template <typename Container, typename T, typename UnaryOp>
+T sum(execution::parallel_policy, Container&& _container, T _init, UnaryOp _term)
+{
+    auto& pool = thread_pool::global();
+    auto partials = std::vector<T>(pool.size(), T{});
+    auto const count = _container.size();
+    auto const chunks = std::min(pool.size(), std::max(count / parallel_grain_size, std::size_t{1}));
+
+    pool.parallel_for(chunks, 1, [&](auto _begin, auto _end) {
+        for (auto chunk = _begin; chunk != _end; ++chunk)
+        {
+            auto acc = T{};
+            for (auto k = count * chunk / chunks; k < count * (chunk + 1) / chunks; ++k)
+                acc = std::move(acc) + _term(_container[k]);
+            partials[chunk] = std::move(acc);
+        }
+    });
+
+    auto result = std::move(_init);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        result = result + partials[chunk];
+    return result;
+}
+
+template <typename Container, typename UnaryPred>
+constexpr bool all_of(execution::sequenced_policy, Container&& _container, UnaryPred _unaryPred)
+{
+    return all_of(std::forward<Container>(_container), std::move(_unaryPred));
+}
+
+template <typename Container, typename UnaryPred>
+constexpr bool all_of(execution::unsequenced_policy, Container&& _container, UnaryPred _unaryPred)
+{
+    return all_of(std::forward<Container>(_container), std::move(_unaryPred));
+}
+
+template <typename Container, typename UnaryPred>
+bool all_of(execution::parallel_policy, Container&& _container, UnaryPred _unaryPred)
+{
+    auto result = std::atomic<bool>{true};
+    thread_pool::global().parallel_for(_container.size(), parallel_grain_size, [&](auto _begin, auto _end) {
+        for (auto k = _begin; k < _end && result.load(std::memory_order_relaxed); ++k)
+            if (!_unaryPred(_container[k]))
+                result.store(false, std::memory_order_relaxed);
+    });
+    return result.load();
+}
+
+} // end namespace
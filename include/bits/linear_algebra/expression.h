@@ -0,0 +1,338 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+#include "vector.h"
+#include "matrix.h"
+#include "operation_traits.h"
+#include "operation_traits_selector.h"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// EXT: lazily evaluated, element-wise matrix and vector expressions.
+//
+// The arithmetic operators of the paper evaluate eagerly, one temporary per operator.
+// Wrapping one operand into lazy() instead makes +, - and scalar * build a (cheap) expression
+// tree, which is evaluated in a single pass over all operands once it is assigned to
+// (or used to construct) a matrix or vector:
+//
+//     dyn_matrix<double> r = lazy(a) + b + c - d;    // one loop, no temporaries
+//
+// Expressions refer to the owning operands they were built from, and thus must not outlive them.
+//
+// Each node carries the operation traits selected for its operands and uses them to determine
+// its result_type. If any node of an expression is subject to customized arithmetic traits of its
+// operation traits, the expression is not fused but evaluated node by node via these traits.
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+namespace detail { // {{{
+    struct identity_op { template <typename T> constexpr auto operator()(T const& a) const { return a; } };
+    struct negate_op { template <typename T> constexpr auto operator()(T const& a) const { return -a; } };
+    struct add_op { template <typename T1, typename T2> constexpr auto operator()(T1 const& a, T2 const& b) const { return a + b; } };
+    struct subtract_op { template <typename T1, typename T2> constexpr auto operator()(T1 const& a, T2 const& b) const { return a - b; } };
+    struct multiply_op { template <typename T1, typename T2> constexpr auto operator()(T1 const& a, T2 const& b) const { return a * b; } };
+
+    template <typename ET> struct is_view_engine : public std::false_type {};
+    template <typename ET, typename VCT, typename VFT> struct is_view_engine<vector_view_engine<ET, VCT, VFT>> : public std::true_type {};
+    template <typename ET, typename MCT, typename VFT> struct is_view_engine<matrix_view_engine<ET, MCT, VFT>> : public std::true_type {};
+
+    /// Type an operand of type X is stored as within an expression node.
+    ///
+    /// Expressions and views are cheap to copy and typically temporaries, so they are held by value,
+    /// whereas matrices and vectors that own their elements are referenced.
+    template <typename X, typename = void>
+    struct expression_operand { using type = X; };
+
+    template <typename ET, typename OT>
+    struct expression_operand<matrix<ET, OT>> {
+        using type = std::conditional_t<is_view_engine<ET>::value, matrix<ET, OT>, matrix<ET, OT> const&>;
+    };
+
+    template <typename ET, typename OT>
+    struct expression_operand<vector<ET, OT>> {
+        using type = std::conditional_t<is_view_engine<ET>::value, vector<ET, OT>, vector<ET, OT> const&>;
+    };
+
+    /// Type an operand of type X evaluates to, as seen by the arithmetic traits.
+    template <typename X, typename = void>
+    struct expression_result { using type = X; };
+
+    template <typename X>
+    struct expression_result<X, std::void_t<typename X::expression_category>> { using type = typename X::result_type; };
+
+    template <typename X>
+    using expression_result_t = typename expression_result<X>::type;
+
+    template <typename X, bool = is_expression_v<X>>
+    struct is_fusable_operand : public std::true_type {};
+
+    template <typename X>
+    struct is_fusable_operand<X, true> : public std::bool_constant<X::is_fusable> {};
+
+    /// Maps an element-wise operation onto the arithmetic traits of the operation traits OT.
+    template <typename OT, typename Op, typename... OP> struct expression_traits;
+
+    template <typename OT, typename OP1>
+    struct expression_traits<OT, identity_op, OP1>
+    {
+        using result_type = OP1;
+        constexpr static bool is_default = true;
+        constexpr static result_type apply(OP1 const& a) { return a; }
+    };
+
+    template <typename OT, typename OP1>
+    struct expression_traits<OT, negate_op, OP1>
+    {
+        using traits = matrix_negation_traits_t<OT, OP1>;
+        using result_type = typename traits::result_type;
+        constexpr static bool is_default = std::is_same_v<traits, matrix_negation_traits<OT, OP1>>;
+        constexpr static result_type apply(OP1 const& a) { return traits::negate(a); }
+    };
+
+    template <typename OT, typename OP1, typename OP2>
+    struct expression_traits<OT, add_op, OP1, OP2>
+    {
+        using traits = matrix_addition_traits_t<OT, OP1, OP2>;
+        using result_type = typename traits::result_type;
+        constexpr static bool is_default = std::is_same_v<traits, matrix_addition_traits<OT, OP1, OP2>>;
+        constexpr static result_type apply(OP1 const& a, OP2 const& b) { return traits::add(a, b); }
+    };
+
+    template <typename OT, typename OP1, typename OP2>
+    struct expression_traits<OT, subtract_op, OP1, OP2>
+    {
+        using traits = matrix_subtraction_traits_t<OT, OP1, OP2>;
+        using result_type = typename traits::result_type;
+        constexpr static bool is_default = std::is_same_v<traits, matrix_subtraction_traits<OT, OP1, OP2>>;
+        constexpr static result_type apply(OP1 const& a, OP2 const& b) { return traits::subtract(a, b); }
+    };
+
+    template <typename OT, typename OP1, typename OP2>
+    struct expression_traits<OT, multiply_op, OP1, OP2>
+    {
+        using traits = matrix_multiplication_traits_t<OT, OP1, OP2>;
+        using result_type = typename traits::result_type;
+        constexpr static bool is_default = std::is_same_v<traits, matrix_multiplication_traits<OT, OP1, OP2>>;
+        constexpr static result_type apply(OP1 const& a, OP2 const& b) { return traits::multiply(a, b); }
+    };
+
+    template <typename X, typename... Index>
+    constexpr decltype(auto) expression_element(X const& x, Index... index)
+    {
+        if constexpr (is_matrix_element_v<X>)
+            return x;
+        else
+            return x(index...);
+    }
+
+    template <typename X>
+    constexpr decltype(auto) evaluate(X const& x)
+    {
+        if constexpr (is_expression_v<X>)
+            return x.eval();
+        else
+            return (x);
+    }
+} // }}}
+
+/**
+ * Lazily evaluated element-wise operation Op on the given operands.
+ *
+ * @param Category   either matrix_expression_tag or vector_expression_tag
+ * @param OT         operation traits the result type is determined with
+ * @param Op         element-wise function object
+ * @param Operands   matrices, vectors, expressions of the same category, or scalars
+ */
+template <typename Category, typename OT, typename Op, typename... Operands>
+class expression {
+    using traits = detail::expression_traits<OT, Op, detail::expression_result_t<Operands>...>;
+
+  public:
+    //- Types
+    //
+    using expression_category = Category;
+    using op_traits = OT;
+    using result_type = typename traits::result_type;
+    using value_type = typename result_type::value_type;
+    using size_type = std::size_t;
+
+    /// Whether the whole expression tree can be evaluated element-wise in a single pass.
+    constexpr static bool is_fusable = traits::is_default && (detail::is_fusable_operand<Operands>::value && ...);
+
+    //- Construct/copy/destroy
+    //
+    constexpr explicit expression(Operands const&... operands) : operands_{operands...} {}
+
+    //- Capacity
+    //
+    constexpr size_type rows() const noexcept { return shape().rows(); }
+    constexpr size_type columns() const noexcept { return shape().columns(); }
+    constexpr auto size() const noexcept { return shape().size(); }
+
+    //- Element access
+    //
+    template <typename... Index>
+    constexpr value_type operator()(Index... index) const
+    {
+        static_assert(is_fusable, "Expressions with customized arithmetic traits can only be evaluated as a whole.");
+        return std::apply([&](auto const&... x) { return value_type(Op{}(detail::expression_element(x, index...)...)); },
+                          operands_);
+    }
+
+    //- Evaluation
+    //
+    /// Evaluates the expression into a new object of its result type.
+    constexpr result_type eval() const
+    {
+        if constexpr (is_fusable)
+            return result_type(*this);
+        else
+            return std::apply([](auto const&... x) { return traits::apply(detail::evaluate(x)...); }, operands_);
+    }
+
+  private:
+    /// The first non-scalar operand, which determines the shape of the result.
+    constexpr auto const& shape() const noexcept
+    {
+        constexpr std::size_t index = [] {
+            constexpr bool scalars[] = {is_matrix_element_v<Operands>...};
+            std::size_t i = 0;
+            while (scalars[i])
+                ++i;
+            return i;
+        }();
+        return std::get<index>(operands_);
+    }
+
+    std::tuple<typename detail::expression_operand<Operands>::type...> operands_;
+};
+
+namespace detail { // {{{
+    /// Expression category and operation traits of an operand of element-wise operations.
+    template <typename X, typename = void> struct operand_traits {};
+
+    template <typename ET, typename OT> struct operand_traits<matrix<ET, OT>> {
+        using category = matrix_expression_tag;
+        using op_traits = OT;
+    };
+
+    template <typename ET, typename OT> struct operand_traits<vector<ET, OT>> {
+        using category = vector_expression_tag;
+        using op_traits = OT;
+    };
+
+    template <typename X> struct operand_traits<X, std::void_t<typename X::expression_category>> {
+        using category = typename X::expression_category;
+        using op_traits = typename X::op_traits;
+    };
+
+    template <typename X, typename = void>
+    constexpr inline bool is_operand_v = false;
+
+    template <typename X>
+    constexpr inline bool is_operand_v<X, std::void_t<typename operand_traits<X>::category>> = true;
+
+    template <typename X>
+    using operand_category_t = typename operand_traits<X>::category;
+
+    template <typename X>
+    using operand_op_traits_t = typename operand_traits<X>::op_traits;
+
+    template <typename X1, typename X2>
+    constexpr inline bool is_element_wise_v = (is_expression_v<X1> || is_expression_v<X2>) && is_operand_v<X1> && is_operand_v<X2>;
+
+    template <typename Op, typename X>
+    constexpr auto make_unary_expression(X const& x)
+    {
+        return expression<operand_category_t<X>, operand_op_traits_t<X>, Op, X>(x);
+    }
+
+    template <typename Op, typename X1, typename X2>
+    constexpr auto make_binary_expression(X1 const& x1, X2 const& x2)
+    {
+        static_assert(std::is_same_v<operand_category_t<X1>, operand_category_t<X2>>,
+                      "Element-wise operations require operands of the same kind (matrix or vector).");
+        using op_traits = matrix_operation_traits_selector_t<operand_op_traits_t<X1>, operand_op_traits_t<X2>>;
+        return expression<operand_category_t<X1>, op_traits, Op, X1, X2>(x1, x2);
+    }
+
+    /// Creates an expression of Op on a matrix or vector expression and a scalar, in either order.
+    template <typename Op, typename X1, typename X2>
+    constexpr auto make_scalar_expression(X1 const& x1, X2 const& x2)
+    {
+        using X = std::conditional_t<is_matrix_element_v<X1>, X2, X1>;
+        return expression<operand_category_t<X>, operand_op_traits_t<X>, Op, X1, X2>(x1, x2);
+    }
+} // }}}
+
+//- Entry points
+//
+/// Marks given matrix as the operand of a lazily evaluated expression.
+template <typename ET, typename OT>
+constexpr auto lazy(matrix<ET, OT> const& m)
+{
+    return detail::make_unary_expression<detail::identity_op>(m);
+}
+
+/// Marks given vector as the operand of a lazily evaluated expression.
+template <typename ET, typename OT>
+constexpr auto lazy(vector<ET, OT> const& v)
+{
+    return detail::make_unary_expression<detail::identity_op>(v);
+}
+
+//- Negation
+//
+template <typename E, std::enable_if_t<is_expression_v<E>, int> = 0>
+constexpr auto operator-(E const& e)
+{
+    return detail::make_unary_expression<detail::negate_op>(e);
+}
+
+//- Addition
+//
+template <typename E1, typename E2, std::enable_if_t<detail::is_element_wise_v<E1, E2>, int> = 0>
+constexpr auto operator+(E1 const& e1, E2 const& e2)
+{
+    return detail::make_binary_expression<detail::add_op>(e1, e2);
+}
+
+//- Subtraction
+//
+template <typename E1, typename E2, std::enable_if_t<detail::is_element_wise_v<E1, E2>, int> = 0>
+constexpr auto operator-(E1 const& e1, E2 const& e2)
+{
+    return detail::make_binary_expression<detail::subtract_op>(e1, e2);
+}
+
+//- Multiplication by scalar
+//
+template <typename E, typename S, std::enable_if_t<is_expression_v<E> && is_matrix_element_v<S>, int> = 0>
+constexpr auto operator*(E const& e, S const& s)
+{
+    return detail::make_scalar_expression<detail::multiply_op>(e, s);
+}
+
+template <typename S, typename E, std::enable_if_t<is_matrix_element_v<S> && is_expression_v<E>, int> = 0>
+constexpr auto operator*(S const& s, E const& e)
+{
+    return detail::make_scalar_expression<detail::multiply_op>(s, e);
+}
+
+} // end namespace
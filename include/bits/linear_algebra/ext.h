@@ -20,7 +20,9 @@
 #include "matrix.h"
 #include "convenience_aliases.h"
 
+#include <cassert>
 #include <ostream>
+#include <utility>
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
 
@@ -46,6 +48,47 @@ constexpr fs_matrix<T, N, N> identity()
     return fs_matrix<T, N, N>([](auto i, auto j) { return kronecker_delta<T>(i, j); });
 }
 
+/// Materializes the transpose of m, unlike m.t(), which is a view of m.
+template <typename ET, typename OT>
+constexpr auto transpose(matrix<ET, OT> const& m)
+{
+    return matrix<detail::transposed_engine_t<ET>, OT>(m.t());
+}
+
+/// Transposes the expiring matrix m by reading its storage in the other layout (see row_major),
+/// i.e. the result is column-major if m is row-major and vice versa. No element is copied or moved.
+template <typename ET, typename OT, std::enable_if_t<detail::has_layout_transpose_v<ET>, int> = 0>
+constexpr auto transpose(matrix<ET, OT>&& m)
+{
+    auto e = std::move(m.engine()).transposed();
+    return matrix<decltype(e), OT>(std::move(e));
+}
+
+/// Transposes the square matrix m in place.
+template <typename ET, typename OT>
+constexpr void transpose_in_place(matrix<ET, OT>& m)
+{
+    assert(m.rows() == m.columns());
+
+    if constexpr (detail::is_flat_compatible_v<ET, ET>)
+    {
+        if (!detail::is_constant_evaluated())
+        {
+            m = std::as_const(m).t(); // recognized as self-assignment, see detail::copy()
+            return;
+        }
+    }
+
+    using detail::times;
+    for (auto i : times(m.rows()))
+        for (auto j : times(i + 1, m.columns() - i - 1))
+        {
+            auto t = m(i, j);
+            m(i, j) = m(j, i);
+            m(j, i) = t;
+        }
+}
+
 template <typename ET1, typename OT1, typename ET2, typename OT2>
 constexpr bool operator==(vector<ET1, OT1> const& v1, vector<ET2, OT2> const& v2) noexcept
 {
@@ -0,0 +1,200 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "arithmetic_operators.h"
+#include "base.h"
+#include "execution.h"
+#include "gemm_kernel.h"
+#include "gemv_kernel.h"
+#include "matrix.h"
+#include "simd.h"
+#include "support.h"
+#include "vector.h"
+
+#include <cassert>
+#include <type_traits>
+
+// EXT: BLAS-style fused updates into caller-owned storage, i.e. without temporaries.
+//
+// The destination is passed last, and may also be a writable view (e.g. m.row(i) or m.t()).
+// It must not alias any of the other operands. Operands exposing (strided) spans of the same
+// arithmetic type run on the SIMD, GEMV and GEMM kernels, all others on plain loops.
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+/// y = alpha * x + y
+template <class ExecutionPolicy, class T, class ET1, class OT1, class VY,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+constexpr void axpy(ExecutionPolicy&& policy, T alpha, vector<ET1, OT1> const& x, VY&& y)
+{
+    using ETY = typename std::remove_reference_t<VY>::engine_type;
+    using value_type = typename ETY::value_type;
+
+    assert(x.size() == y.size());
+
+    if constexpr (detail::is_flat_compatible_v<ETY, ET1>)
+    {
+        auto const a = x.span();
+        auto const r = y.span();
+        if (!detail::is_constant_evaluated() && detail::is_flat(r, a))
+        {
+            auto const s = value_type(alpha);
+            detail::simd::for_chunks<value_type>(policy, r.size(), [&](std::size_t k, std::size_t end) {
+                detail::simd::axpy(end - k, s, a.data() + k, r.data() + k);
+            });
+            return;
+        }
+    }
+
+    detail::for_each(policy, detail::times(y.size()), [&](auto i) { y(i) = alpha * x(i) + y(i); });
+}
+
+/// Y = alpha * X + Y
+template <class ExecutionPolicy, class T, class ET1, class OT1, class MY,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+constexpr void axpy(ExecutionPolicy&& policy, T alpha, matrix<ET1, OT1> const& x, MY&& y)
+{
+    using ETY = typename std::remove_reference_t<MY>::engine_type;
+    using value_type = typename ETY::value_type;
+
+    assert(x.size() == y.size());
+
+    if constexpr (detail::is_flat_compatible_v<ETY, ET1>)
+    {
+        auto const a = x.span();
+        auto const r = y.span();
+        auto const s = value_type(alpha);
+        auto const kernel = [&](auto p, std::size_t n, value_type* ry, value_type const* rx) {
+            detail::simd::for_chunks<value_type>(p, n, [&](std::size_t k, std::size_t end) {
+                detail::simd::axpy(end - k, s, rx + k, ry + k);
+            });
+        };
+        if (!detail::is_constant_evaluated() && detail::for_each_run(policy, kernel, r, a))
+            return;
+    }
+
+    using detail::times;
+    detail::for_each(policy, times(y.rows()) * times(y.columns()), [&](auto ij) {
+        auto const [i, j] = ij;
+        y(i, j) = alpha * x(i, j) + y(i, j);
+    });
+}
+
+/// y = alpha * A * x + beta * y
+///
+/// If beta is zero, y is only written to, i.e. it may be uninitialized (or hold NaNs).
+template <class ExecutionPolicy, class T1, class ET1, class OT1, class ET2, class OT2, class T2, class VY,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+constexpr void gemv(ExecutionPolicy&& policy, T1 alpha, matrix<ET1, OT1> const& a, vector<ET2, OT2> const& x, T2 beta, VY&& y)
+{
+    using ETY = typename std::remove_reference_t<VY>::engine_type;
+    using value_type = typename ETY::value_type;
+
+    assert(a.columns() == x.size() && a.rows() == y.size());
+
+    if constexpr (detail::is_flat_compatible_v<ETY, ET1, ET2>)
+    {
+        auto const sa = a.span();
+        auto const sx = x.span();
+        auto const sy = y.span();
+        if (!detail::is_constant_evaluated() && sx.is_contiguous() && sy.is_contiguous())
+        {
+            detail::gemv(policy, sa.rows(), sa.columns(), value_type(alpha),
+                         sa.data(), sa.row_stride(), sa.column_stride(),
+                         sx.data(), value_type(beta), sy.data());
+            return;
+        }
+    }
+
+    using detail::times;
+    using detail::reduce;
+    detail::for_each(policy, times(a.rows()), [&](auto i) {
+        auto const ax = alpha * reduce(times(a.columns()), value_type{}, [&](auto acc, auto j) { return acc + a(i, j) * x(j); });
+        y(i) = beta == T2{} ? value_type(ax) : value_type(ax + beta * y(i));
+    });
+}
+
+/// C = alpha * A * B + beta * C
+///
+/// If beta is zero, C is only written to, i.e. it may be uninitialized (or hold NaNs).
+template <class ExecutionPolicy, class T1, class ET1, class OT1, class ET2, class OT2, class T2, class MC,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+constexpr void gemm(ExecutionPolicy&& policy, T1 alpha, matrix<ET1, OT1> const& a, matrix<ET2, OT2> const& b, T2 beta, MC&& c)
+{
+    using ETC = typename std::remove_reference_t<MC>::engine_type;
+    using value_type = typename ETC::value_type;
+
+    assert(a.columns() == b.rows() && a.rows() == c.rows() && b.columns() == c.columns());
+
+    if constexpr (detail::is_gemm_compatible_v<ET1, ET2, ETC>)
+    {
+        if (!detail::is_constant_evaluated())
+        {
+            auto const sa = a.span();
+            auto const sb = b.span();
+            auto const sc = c.span();
+            detail::gemm(policy, sa.rows(), sb.columns(), sa.columns(),
+                         value_type(alpha),
+                         sa.data(), sa.row_stride(), sa.column_stride(),
+                         sb.data(), sb.row_stride(), sb.column_stride(),
+                         value_type(beta),
+                         sc.data(), sc.row_stride(), sc.column_stride());
+            return;
+        }
+    }
+
+    using detail::times;
+    using detail::reduce;
+    detail::for_each(policy, times(c.rows()) * times(c.columns()), [&](auto ij) {
+        auto const [i, j] = ij;
+        auto const ab = alpha * reduce(times(a.columns()), value_type{}, [&, i = i, j = j](auto acc, auto k) {
+            return acc + a(i, k) * b(k, j);
+        });
+        c(i, j) = beta == T2{} ? value_type(ab) : value_type(ab + beta * c(i, j));
+    });
+}
+
+//- Overloads with the execution policy of the destination's operation traits.
+//
+template <class T, class ET1, class OT1, class Y>
+constexpr void axpy(T alpha, vector<ET1, OT1> const& x, Y&& y)
+{
+    using OT = typename detail::arithmetic_op_traits<std::decay_t<Y>>::type;
+    axpy(execution_policy_t<OT>{}, alpha, x, std::forward<Y>(y));
+}
+
+template <class T, class ET1, class OT1, class Y>
+constexpr void axpy(T alpha, matrix<ET1, OT1> const& x, Y&& y)
+{
+    using OT = typename detail::arithmetic_op_traits<std::decay_t<Y>>::type;
+    axpy(execution_policy_t<OT>{}, alpha, x, std::forward<Y>(y));
+}
+
+template <class T1, class ET1, class OT1, class ET2, class OT2, class T2, class Y>
+constexpr void gemv(T1 alpha, matrix<ET1, OT1> const& a, vector<ET2, OT2> const& x, T2 beta, Y&& y)
+{
+    using OT = typename detail::arithmetic_op_traits<std::decay_t<Y>>::type;
+    gemv(execution_policy_t<OT>{}, alpha, a, x, beta, std::forward<Y>(y));
+}
+
+template <class T1, class ET1, class OT1, class ET2, class OT2, class T2, class C>
+constexpr void gemm(T1 alpha, matrix<ET1, OT1> const& a, matrix<ET2, OT2> const& b, T2 beta, C&& c)
+{
+    using OT = typename detail::arithmetic_op_traits<std::decay_t<C>>::type;
+    gemm(execution_policy_t<OT>{}, alpha, a, b, beta, std::forward<C>(c));
+}
+
+} // end namespace
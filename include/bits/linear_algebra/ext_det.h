@@ -18,232 +18,109 @@
 #include "matrix.h"
 #include "fs_matrix_engine.h"
 #include "dr_matrix_engine.h"
-#include "ext_permutation.h"
+#include "ext_lu.h"
 #include "submatrix_engine.h"
 #include "support.h"
 #include "concepts.h"
+#include "unrolled_kernel.h"
 
 #include <cassert>
+#include <stdexcept>
+#include <type_traits>
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
 
 namespace detail { // {{{
-    template <typename ET, typename OT>
-    constexpr auto weigh_trivials_in_row(matrix<ET, OT> const& m, size_t i)
-    {
-        typename ET::size_type c = 0;
-        for (auto j : times(0u, m.columns()))
-        {
-            auto const v = m(i, j);
-            auto const w = v < 0 ? -v : v;
-            if (w == 0 || w == 1 || w == 2)
-                c += 3 - w;
-        }
-        return c;
-    }
-
-    template <typename ET, typename OT>
-    constexpr auto weigh_trivials_in_column(matrix<ET, OT> const& m, size_t j)
-    {
-        std::size_t c = 0;
-        for (std::size_t i : times(0u, m.rows()))
-        {
-            auto const v = m(i, j);
-            auto const w = v < 0 ? -v : v;
-            if (w == 0 || w == 1 || w == 2)
-                c += 3 - w;
-        }
-
-        return c;
-    }
-
     /**
-     * Finds the best matrix row or column to expand by.
+     * Determinant of the N x N matrix m in closed form, N <= 4.
      *
-     * @returns a pair whose first argument is the row or column index and the second argument
-     *          determines whether or not the first one is a row index (column index otherwise).
+     * m only needs to be indexable as m(i, j), so that this also serves the matrices of a batch
+     * (see fs_matrix_batch). The 4x4 determinant is expanded along the 2x2 subdeterminants of the
+     * upper and the lower two rows, as in closed_form_adjugate().
      */
-    template <typename ET, typename OT>
-    constexpr std::pair<std::size_t, bool> find_expansion_vector(matrix<ET, OT> const& a) noexcept
+    template <std::size_t N, typename T, typename M>
+    constexpr T closed_form_det(M const& m)
     {
-        std::size_t expansion_index = 0;
-        std::size_t most_trivials = weigh_trivials_in_row(a, 0);
-
-        for (std::size_t k : times(1u, a.columns() - 1))
-            if (auto const c = weigh_trivials_in_row(a, k); c > most_trivials)
-            {
-                expansion_index = k;
-                most_trivials = c;
-            }
+        static_assert(1 <= N && N <= 4);
 
-        bool expandByRow = true;
-        for (std::size_t k : times(0u, a.columns()))
-            if (auto const c = weigh_trivials_in_column(a, k); c > most_trivials)
-            {
-                expandByRow = false;
-                expansion_index = k;
-                most_trivials = c;
-            }
-
-        return {expansion_index, expandByRow};
-    }
-} // }}}
-
-#if 0 // {{{ det(A)
-template <typename ET, typename OT>
-constexpr auto det(matrix<ET, OT> const& m) // -> typename matrix<ET, OT>::value_type
-{
-    using detail::times;
-    using detail::reduce;
-
-    if (m.rows() != m.columns())
-        return 0; // TODO
-    else if (m.rows() == 3)
-        return m(0, 0) * m(1, 1) * m(2, 2)
-             + m(1, 0) * m(2, 1) * m(0, 2)
-             + m(2, 0) * m(0, 1) * m(1, 2)
-             - m(2, 0) * m(1, 1) * m(0, 2)
-             - m(2, 1) * m(1, 2) * m(0, 0)
-             - m(2, 2) * m(1, 0) * m(0, 1);
-    else if (m.rows() == 2)
-        return m(0, 0) * m(1, 1)
-             - m(1, 0) * m(0, 1);
-    else if (m.rows() == 1)
-        return m(0, 0);
-    else
-    {
-        using detail::times;
-        using detail::reduce;
+        if constexpr (N == 1)
+            return m(0, 0);
+        else if constexpr (N == 2)
+            return m(0, 0) * m(1, 1)
+                 - m(1, 0) * m(0, 1);
+        else if constexpr (N == 3)
+            return m(0, 0) * m(1, 1) * m(2, 2)
+                 + m(1, 0) * m(2, 1) * m(0, 2)
+                 + m(2, 0) * m(0, 1) * m(1, 2)
+                 - m(2, 0) * m(1, 1) * m(0, 2)
+                 - m(2, 1) * m(1, 2) * m(0, 0)
+                 - m(2, 2) * m(1, 0) * m(0, 1);
+        else
+        {
+            T const s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+            T const s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+            T const s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+            T const s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+            T const s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+            T const s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
 
-        auto const [expansion_index, expandByRow] = detail::find_expansion_vector(m);
+            T const c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+            T const c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+            T const c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+            T const c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+            T const c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+            T const c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
 
-        if (expandByRow)
-        {
-            std::size_t const i = expansion_index;
-            return reduce(
-                times(m.columns()),
-                0,
-                [&](auto acc, auto j) constexpr {
-                    return (i + j) % 2 == 0
-                        ? acc + m(i, j) * det(m.submatrix(i, j))
-                        : acc - m(i, j) * det(m.submatrix(i, j));
-                }
-            );
-        }
-        else // expand by row
-        {
-            std::size_t const j = expansion_index;
-            return reduce(
-                times(m.columns()),
-                0,
-                [&](auto acc, auto i) constexpr {
-                    return (i + j) % 2 == 0
-                        ? acc + m(i, j) * det(m.submatrix(i, j))
-                        : acc - m(i, j) * det(m.submatrix(i, j));
-                }
-            );
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
         }
     }
-}
+} // }}}
 
-template <class T, std::size_t R, std::size_t C>
-constexpr T det(matrix<fs_matrix_engine<T, R, C>> const& a) LA_CONCEPT(R == C)
+template <class T, class L, class OT> constexpr T det(matrix<fs_matrix_engine<T, 1, 1, L>, OT> const& m)
 {
-    using detail::times;
-    using detail::reduce;
-
-    auto const [expansion_index, expandByRow] = detail::find_expansion_vector(a);
-
-    if (expandByRow)
-    {
-        std::size_t const i = expansion_index;
-        return reduce(
-            times(C),
-            0,
-            [&](auto acc, auto j) constexpr {
-                return (i + j) % 2 == 0
-                    ? acc + a(i, j) * det(a.submatrix(i, j))
-                    : acc - a(i, j) * det(a.submatrix(i, j));
-            }
-        );
-    }
-    else // expand by row
-    {
-        std::size_t const j = expansion_index;
-        return reduce(
-            times(a.columns()),
-            0,
-            [&](auto acc, auto i) constexpr {
-                return (i + j) % 2 == 0
-                    ? acc + a(i, j) * det(a.submatrix(i, j))
-                    : acc - a(i, j) * det(a.submatrix(i, j));
-            }
-        );
-    }
+    return detail::closed_form_det<1, T>(m);
 }
-#endif // }}}
 
-template <class T, class OT> constexpr T det(matrix<fs_matrix_engine<T, 1, 1>, OT> const& m)
+template <class T, class L, class OT> constexpr T det(matrix<fs_matrix_engine<T, 2, 2, L>, OT> const& m)
 {
-    return m(0, 0);
+    return detail::closed_form_det<2, T>(m);
 }
 
-template <class T, class OT> constexpr T det(matrix<fs_matrix_engine<T, 2, 2>, OT> const& m)
+template <class T, class L, class OT> constexpr T det(matrix<fs_matrix_engine<T, 3, 3, L>, OT> const& m)
 {
-    return m(0, 0) * m(1, 1)
-         - m(1, 0) * m(0, 1);
+    return detail::closed_form_det<3, T>(m);
 }
 
-template <class T, class OT> constexpr T det(matrix<fs_matrix_engine<T, 3, 3>, OT> const& m)
+/// Computes the determinant of a square matrix in O(n^3).
+///
+/// Matrices with a field element type are LU-decomposed, integral matrices are reduced with the
+/// fraction-free Bareiss algorithm, so that their determinant stays exact.
+template <typename ET, typename OT>
+constexpr auto det(matrix<ET, OT> const& m) -> typename ET::value_type
 {
-    return m(0, 0) * m(1, 1) * m(2, 2)
-         + m(1, 0) * m(2, 1) * m(0, 2)
-         + m(2, 0) * m(0, 1) * m(1, 2)
-         - m(2, 0) * m(1, 1) * m(0, 2)
-         - m(2, 1) * m(1, 2) * m(0, 0)
-         - m(2, 2) * m(1, 0) * m(0, 1);
-}
+    using value_type = typename ET::value_type;
+    using engine_type = detail::factorization_engine_t<ET>;
 
-template <class T, class OT, std::size_t N> constexpr T det(matrix<fs_matrix_engine<T, N, N>, OT> const& m)
-{
-    return detail::reduce(
-        permutation<N>::all(),
-        T{},
-        [&](T acc, auto const& pi) {
-            return acc + sgn(pi) * detail::reduce(
-                detail::times(1, pi.size()),
-                T{1},
-                [&](auto a, auto i) constexpr { return a * m(i - 1, pi(i) - 1); });
-        }
-    );
-}
+    assert(m.rows() == m.columns());
 
-template <class T, class OT, std::size_t N> constexpr T det(
-    matrix<submatrix_engine<fs_matrix_engine<T, N, N>,
-                            typename fs_matrix_engine<T, N, N>::engine_category>, OT> const& m)
-{
-    printf("det with N=%zu, size=(%zu, %zu)\n", N, m.rows(), m.columns());
-    return detail::reduce(
-        permutation<N - 2>::all(),
-        T{},
-        [&](T acc, auto const& pi) {
-            return acc + sgn(pi) * detail::reduce(
-                detail::times(1, pi.size()),
-                T{1},
-                [&](auto a, auto i) constexpr {
-                    return a * m(i - 1, pi(i) - 1);
-                }
-            );
-        }
-    );
+    if (m.rows() == 0)
+        return value_type(1);
+    else if constexpr (std::is_integral_v<value_type>)
+        return detail::bareiss_det(matrix<engine_type, OT>(m));
+    else
+        return lu_factorization<engine_type, OT>(m).det();
 }
 
 /// Tests whether or not given matrix is invertible.
 template <typename ET, typename OT>
 constexpr bool is_invertible(matrix<ET, OT> const& m)
 {
-    auto const zero = typename ET::value_type{};
-    return det(m) != zero;
+    using value_type = typename ET::value_type;
+
+    if constexpr (std::is_integral_v<value_type>)
+        return det(m) != value_type{};
+    else
+        return !lu_factorization(m).is_singular();
 }
 
 /// Computes the cofactor of a square matrix m at given position (i, j).
@@ -279,21 +156,395 @@ constexpr matrix<ET, OT> adjugate(matrix<ET, OT> const& m)
     }
 }
 
-/// Computes the inverse matrix of a square matrix.
+namespace detail { // {{{
+    [[noreturn]] inline void throw_not_invertible()
+    {
+        throw std::domain_error{"Given matrix is not invertible."};
+    }
+
+    /// Tests whether fs matrices of engine type ET are inverted in closed form.
+    template <typename ET>
+    struct has_closed_form_inverse : public std::false_type {};
+
+    template <typename T, std::size_t N, typename L>
+    struct has_closed_form_inverse<fs_matrix_engine<T, N, N, L>> : public std::bool_constant<1 <= N && N <= 4> {};
+
+    template <typename ET>
+    constexpr inline bool has_closed_form_inverse_v = has_closed_form_inverse<ET>::value;
+
+    /**
+     * Stores the adjugate of the N x N matrix m (2 <= N <= 4) to r, and returns the determinant of m,
+     * both in closed form.
+     *
+     * m and r only need to be indexable as m(i, j), like in closed_form_det(). The 4x4 cofactors are
+     * expanded along the 2x2 subdeterminants of the upper two rows (s) and the lower two rows (c),
+     * so that each of them is computed only once.
+     */
+    template <std::size_t N, typename T, typename M, typename R>
+    constexpr T closed_form_adjugate(M const& m, R&& r)
+    {
+        static_assert(2 <= N && N <= 4);
+
+        if constexpr (N == 2)
+        {
+            r(0, 0) =  m(1, 1); r(0, 1) = -m(0, 1);
+            r(1, 0) = -m(1, 0); r(1, 1) =  m(0, 0);
+            return closed_form_det<2, T>(m);
+        }
+        else if constexpr (N == 3)
+        {
+            T const c00 = m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1);
+            T const c01 = m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2);
+            T const c02 = m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0);
+
+            r(0, 0) = c00; r(0, 1) = m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2); r(0, 2) = m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1);
+            r(1, 0) = c01; r(1, 1) = m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0); r(1, 2) = m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2);
+            r(2, 0) = c02; r(2, 1) = m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1); r(2, 2) = m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+
+            return m(0, 0) * c00 + m(0, 1) * c01 + m(0, 2) * c02;
+        }
+        else
+        {
+            T const s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+            T const s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+            T const s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+            T const s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+            T const s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+            T const s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+
+            T const c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+            T const c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+            T const c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+            T const c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+            T const c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+            T const c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+
+            r(0, 0) =  m(1, 1) * c5 - m(1, 2) * c4 + m(1, 3) * c3;
+            r(0, 1) = -m(0, 1) * c5 + m(0, 2) * c4 - m(0, 3) * c3;
+            r(0, 2) =  m(3, 1) * s5 - m(3, 2) * s4 + m(3, 3) * s3;
+            r(0, 3) = -m(2, 1) * s5 + m(2, 2) * s4 - m(2, 3) * s3;
+
+            r(1, 0) = -m(1, 0) * c5 + m(1, 2) * c2 - m(1, 3) * c1;
+            r(1, 1) =  m(0, 0) * c5 - m(0, 2) * c2 + m(0, 3) * c1;
+            r(1, 2) = -m(3, 0) * s5 + m(3, 2) * s2 - m(3, 3) * s1;
+            r(1, 3) =  m(2, 0) * s5 - m(2, 2) * s2 + m(2, 3) * s1;
+
+            r(2, 0) =  m(1, 0) * c4 - m(1, 1) * c2 + m(1, 3) * c0;
+            r(2, 1) = -m(0, 0) * c4 + m(0, 1) * c2 - m(0, 3) * c0;
+            r(2, 2) =  m(3, 0) * s4 - m(3, 1) * s2 + m(3, 3) * s0;
+            r(2, 3) = -m(2, 0) * s4 + m(2, 1) * s2 - m(2, 3) * s0;
+
+            r(3, 0) = -m(1, 0) * c3 + m(1, 1) * c1 - m(1, 2) * c0;
+            r(3, 1) =  m(0, 0) * c3 - m(0, 1) * c1 + m(0, 2) * c0;
+            r(3, 2) = -m(3, 0) * s3 + m(3, 1) * s1 - m(3, 2) * s0;
+            r(3, 3) =  m(2, 0) * s3 - m(2, 1) * s1 + m(2, 2) * s0;
+
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        }
+    }
+
+    /// Inverse of an N x N fs matrix (2 <= N <= 4), as its adjugate over its determinant.
+    template <std::size_t N, typename T, typename L, typename OT>
+    constexpr auto closed_form_inverse(matrix<fs_matrix_engine<T, N, N, L>, OT> const& m)
+    {
+        auto r = matrix<fs_matrix_engine<T, N, N, L>, OT>{};
+        auto const d = closed_form_adjugate<N, T>(m, r);
+        if (d == T{})
+            throw_not_invertible();
+
+        auto const s = T(1) / d;
+        unrolled<N, N>([&](auto i, auto j) { r(i, j) = s * r(i, j); });
+        return r;
+    }
+
+    namespace simd {
+#if LA_SIMD_ISA > 0
+        /// (x[I0], x[I1], y[I2], y[I3])
+        template <int I0, int I1, int I2, int I3>
+        inline __m128 shuffle(__m128 x, __m128 y) noexcept
+        {
+            return _mm_shuffle_ps(x, y, _MM_SHUFFLE(I3, I2, I1, I0));
+        }
+
+        /**
+         * r = inverse(a) of 4x4 floats by Cramer's rule, i.e. closed_form_adjugate() across the SSE lanes.
+         *
+         * The twelve 2x2 subdeterminants s and c are computed four at a time, and each row of the
+         * adjugate at once, as a combination of the columns of a (with their rows swapped pairwise)
+         * with the broadcast (c_k, c_k, s_k, s_k). The rows of a and r are contiguous. For column-major
+         * matrices, this inverts the transpose into the transposed inverse, i.e. into the same layout.
+         *
+         * @return det(a), with r left unwritten if it is 0.
+         */
+        inline float inverse_4x4(float const* a, float* r) noexcept
+        {
+            __m128 const a0 = _mm_loadu_ps(a);
+            __m128 const a1 = _mm_loadu_ps(a + 4);
+            __m128 const a2 = _mm_loadu_ps(a + 8);
+            __m128 const a3 = _mm_loadu_ps(a + 12);
+
+            // (s0, s1, s2, s3), (c0, c1, c2, c3) and (s4, s5, c4, c5), s_k and c_k being of the same two columns
+            auto const det2 = [](__m128 u0, __m128 v0, __m128 u1, __m128 v1) {
+                return _mm_sub_ps(_mm_mul_ps(u0, v1), _mm_mul_ps(v0, u1));
+            };
+            __m128 const s = det2(shuffle<0, 0, 0, 1>(a0, a0), shuffle<0, 0, 0, 1>(a1, a1),
+                                  shuffle<1, 2, 3, 2>(a0, a0), shuffle<1, 2, 3, 2>(a1, a1));
+            __m128 const c = det2(shuffle<0, 0, 0, 1>(a2, a2), shuffle<0, 0, 0, 1>(a3, a3),
+                                  shuffle<1, 2, 3, 2>(a2, a2), shuffle<1, 2, 3, 2>(a3, a3));
+            __m128 const h = det2(shuffle<1, 2, 1, 2>(a0, a2), shuffle<1, 2, 1, 2>(a1, a3),
+                                  shuffle<3, 3, 3, 3>(a0, a2), shuffle<3, 3, 3, 3>(a1, a3));
+
+            __m128 const k0 = shuffle<0, 0, 0, 0>(c, s);
+            __m128 const k1 = shuffle<1, 1, 1, 1>(c, s);
+            __m128 const k2 = shuffle<2, 2, 2, 2>(c, s);
+            __m128 const k3 = shuffle<3, 3, 3, 3>(c, s);
+            __m128 const k4 = shuffle<2, 2, 0, 0>(h, h);
+            __m128 const k5 = shuffle<3, 3, 1, 1>(h, h);
+
+            // column j of a, as (a(1, j), a(0, j), a(3, j), a(2, j))
+            __m128 const t0 = _mm_unpacklo_ps(a1, a0);
+            __m128 const t1 = _mm_unpacklo_ps(a3, a2);
+            __m128 const t2 = _mm_unpackhi_ps(a1, a0);
+            __m128 const t3 = _mm_unpackhi_ps(a3, a2);
+            __m128 const m0 = _mm_movelh_ps(t0, t1);
+            __m128 const m1 = _mm_movehl_ps(t1, t0);
+            __m128 const m2 = _mm_movelh_ps(t2, t3);
+            __m128 const m3 = _mm_movehl_ps(t3, t2);
+
+            // rows of the adjugate, with the signs of lanes 1 and 3 flipped
+            auto const mad = [](__m128 x, __m128 y, __m128 z) { return _mm_add_ps(_mm_mul_ps(x, y), z); };
+            __m128 const r0 = mad(m3, k3, _mm_sub_ps(_mm_mul_ps(m1, k5), _mm_mul_ps(m2, k4)));
+            __m128 const r1 = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(m2, k2), _mm_mul_ps(m0, k5)), _mm_mul_ps(m3, k1));
+            __m128 const r2 = mad(m3, k0, _mm_sub_ps(_mm_mul_ps(m0, k4), _mm_mul_ps(m1, k2)));
+            __m128 const r3 = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(m1, k1), _mm_mul_ps(m0, k3)), _mm_mul_ps(m2, k0));
+
+            // det(a), expanded along its first row, i.e. the first column of the adjugate
+            __m128 const p = _mm_mul_ps(a0, _mm_movelh_ps(_mm_unpacklo_ps(r0, r1), _mm_unpacklo_ps(r2, r3)));
+            __m128 const q = _mm_add_ps(p, _mm_movehl_ps(p, p));
+            float const d = _mm_cvtss_f32(_mm_add_ss(q, shuffle<1, 1, 1, 1>(q, q)));
+            if (d == 0.0f)
+                return d;
+
+            __m128 const f = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f), _mm_set1_ps(d));
+            _mm_storeu_ps(r, _mm_mul_ps(r0, f));
+            _mm_storeu_ps(r + 4, _mm_mul_ps(r1, f));
+            _mm_storeu_ps(r + 8, _mm_mul_ps(r2, f));
+            _mm_storeu_ps(r + 12, _mm_mul_ps(r3, f));
+            return d;
+        }
+#endif
+    }
+
+    /**
+     * Inverts a square matrix of field element type in place, using Gauss-Jordan elimination with
+     * partial pivoting in O(n^3).
+     *
+     * @retval false if the matrix is singular, in which case its contents are unspecified.
+     */
+    template <typename ET, typename OT>
+    constexpr bool gauss_jordan_invert(matrix<ET, OT>& m)
+    {
+        using value_type = typename ET::value_type;
+        using size_type = typename ET::size_type;
+
+        auto const n = m.rows();
+        auto pivots = typename pivot_storage<factorization_engine_t<ET>>::type{};
+        if constexpr (is_resizable_engine_v<factorization_engine_t<ET>>)
+            pivots.resize(n);
+
+        for (size_type k = 0; k < n; ++k)
+        {
+            size_type p = k;
+            auto largest = magnitude(m(k, k));
+            for (size_type i = k + 1; i < n; ++i)
+                if (auto const v = magnitude(m(i, k)); largest < v)
+                {
+                    p = i;
+                    largest = v;
+                }
+
+            pivots[k] = p;
+            if (p != k)
+                m.swap_rows(k, p);
+
+            if (m(k, k) == value_type{})
+                return false;
+
+            auto const s = value_type(1) / m(k, k);
+            m(k, k) = value_type(1);
+            for (size_type j = 0; j < n; ++j)
+                m(k, j) = m(k, j) * s;
+
+            for (size_type i = 0; i < n; ++i)
+            {
+                if (i == k)
+                    continue;
+                auto const f = m(i, k);
+                if (f == value_type{})
+                    continue;
+                m(i, k) = value_type{};
+                for (size_type j = 0; j < n; ++j)
+                    m(i, j) = m(i, j) - f * m(k, j);
+            }
+        }
+
+        // The row interchanges of A become column interchanges of its inverse.
+        for (size_type k = n; k-- > 0; )
+            if (pivots[k] != k)
+                m.swap_columns(k, pivots[k]);
+
+        return true;
+    }
+
+    /**
+     * Inverts a square matrix of integral element type in place, using fraction-free Gauss-Jordan
+     * (Bareiss) elimination, which computes d * inverse(A), with d = +/- det(A), exactly in O(n^3).
+     *
+     * Like the adjugate-based formula, the result is only integral if A is unimodular.
+     *
+     * @retval false if the matrix is singular, in which case its contents are unspecified.
+     */
+    template <typename ET, typename OT>
+    constexpr bool bareiss_invert(matrix<ET, OT>& m)
+    {
+        using value_type = typename ET::value_type;
+        using size_type = typename ET::size_type;
+
+        auto const n = m.rows();
+        auto a = matrix<factorization_engine_t<ET>, OT>(m);
+        auto previous = value_type(1);
+
+        for (auto [i, j] : times(n) * times(n))
+            m(i, j) = i == j ? value_type(1) : value_type{};
+
+        for (size_type k = 0; k < n; ++k)
+        {
+            if (a(k, k) == value_type{})
+            {
+                size_type p = k + 1;
+                while (p < n && a(p, k) == value_type{})
+                    ++p;
+                if (p == n)
+                    return false;
+                a.swap_rows(k, p);
+                m.swap_rows(k, p);
+            }
+
+            auto const pivot = a(k, k);
+            for (size_type i = 0; i < n; ++i)
+            {
+                if (i == k)
+                    continue;
+                auto const f = a(i, k);
+                for (size_type j = 0; j < n; ++j)
+                {
+                    if (j != k)
+                        a(i, j) = (pivot * a(i, j) - f * a(k, j)) / previous;
+                    m(i, j) = (pivot * m(i, j) - f * m(k, j)) / previous;
+                }
+                a(i, k) = value_type{};
+            }
+            previous = pivot;
+        }
+
+        auto const one = value_type(1);
+        for (auto [i, j] : times(n) * times(n))
+            m(i, j) = one / previous * m(i, j);
+
+        return true;
+    }
+} // }}}
+
+/// Computes the inverse of a 1x1 matrix.
+template <typename T, typename L, typename OT>
+constexpr auto inverse(matrix<fs_matrix_engine<T, 1, 1, L>, OT> const& m)
+{
+    if (m(0, 0) == T{})
+        detail::throw_not_invertible();
+
+    return matrix<fs_matrix_engine<T, 1, 1, L>, OT>{T(1) / m(0, 0)};
+}
+
+/// Computes the inverse of a 2x2 matrix in closed form.
+template <typename T, typename L, typename OT>
+constexpr auto inverse(matrix<fs_matrix_engine<T, 2, 2, L>, OT> const& m)
+{
+    return detail::closed_form_inverse<2, T>(m);
+}
+
+/// Computes the inverse of a 3x3 matrix in closed form.
+template <typename T, typename L, typename OT>
+constexpr auto inverse(matrix<fs_matrix_engine<T, 3, 3, L>, OT> const& m)
+{
+    return detail::closed_form_inverse<3, T>(m);
+}
+
+/// Computes the inverse of a 4x4 matrix in closed form, of floats with SSE at run time.
+///
+/// For affine or rigid transforms, see inverse_affine() and inverse_rigid().
+template <typename T, typename L, typename OT>
+constexpr auto inverse(matrix<fs_matrix_engine<T, 4, 4, L>, OT> const& m)
+{
+#if LA_SIMD_ISA > 0
+    if constexpr (std::is_same_v<T, float>)
+    {
+        if (!detail::is_constant_evaluated())
+        {
+            auto r = matrix<fs_matrix_engine<T, 4, 4, L>, OT>(uninitialized);
+            if (detail::simd::inverse_4x4(m.span().data(), r.span().data()) == 0.0f)
+                detail::throw_not_invertible();
+            return r;
+        }
+    }
+#endif
+    return detail::closed_form_inverse<4, T>(m);
+}
+
+/// Inverts a square matrix in place, in O(n^3).
+///
+/// @throws std::domain_error if the matrix is singular.
 template <typename ET, typename OT>
-constexpr auto inverse(matrix<ET, OT> const& m)
+constexpr void invert(matrix<ET, OT>& m)
 {
-    // TODO
-    // if constexpr (is_fixed_size_engine_v<ET>)
-    //     static_assert(is_invertible(m));
+    assert(m.rows() == m.columns());
 
-    auto const detM = det(m);
-    // auto const zero = typename ET::value_type{};
-    // if (detM == zero)
-    //     throw std::domain_error{"Given matrix is not invertible."};
+    if constexpr (detail::has_closed_form_inverse_v<ET>)
+        m = inverse(m);
+    else if constexpr (std::is_integral_v<typename ET::value_type>)
+    {
+        if (!detail::bareiss_invert(m))
+            detail::throw_not_invertible();
+    }
+    else if (!detail::gauss_jordan_invert(m))
+        detail::throw_not_invertible();
+}
+
+/// Computes the inverse of a square matrix into the given output matrix, reusing its storage.
+///
+/// @throws std::domain_error if the matrix is singular.
+template <typename ET1, typename OT1, typename ET2, typename OT2>
+constexpr void inverse_into(matrix<ET1, OT1> const& m, matrix<ET2, OT2>& out)
+{
+    assert(m.rows() == m.columns());
+
+    if constexpr (is_resizable_engine_v<ET2>)
+        out.resize(m.rows(), m.columns());
+
+    for (auto [i, j] : detail::times(m.rows()) * detail::times(m.columns()))
+        out(i, j) = m(i, j);
 
-    auto const one = typename ET::value_type(1);
-    return one / detM * adjugate(m);
+    invert(out);
+}
+
+/// Computes the inverse matrix of a square matrix in O(n^3).
+///
+/// @throws std::domain_error if the matrix is singular.
+template <typename ET, typename OT>
+constexpr auto inverse(matrix<ET, OT> const& m)
+{
+    auto x = matrix<detail::factorization_engine_t<ET>, OT>(m);
+    invert(x);
+    return x;
 }
 
 } // end namespace
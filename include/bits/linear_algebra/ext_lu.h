@@ -0,0 +1,362 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+#include "matrix.h"
+#include "vector.h"
+#include "fs_matrix_engine.h"
+#include "dr_matrix_engine.h"
+#include "fs_vector_engine.h"
+#include "dr_vector_engine.h"
+#include "support.h"
+
+#include <array>
+#include <cassert>
+#include <complex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+namespace detail { // {{{
+    /// Magnitude of a matrix element, as used for pivot selection.
+    template <typename T>
+    constexpr auto magnitude(T const& x)
+    {
+        if constexpr (is_complex_v<T>)
+            return std::abs(x);
+        else
+            return x < T{} ? -x : x;
+    }
+
+    /// Owning engine type a matrix of engine type ET is copied into in order to be factorized.
+    template <typename ET>
+    struct factorization_engine { using type = dr_matrix_engine<typename ET::value_type>; };
+
+    template <typename T, std::size_t R, std::size_t C, typename L>
+    struct factorization_engine<fs_matrix_engine<T, R, C, L>> { using type = fs_matrix_engine<T, R, C, L>; };
+
+    template <typename T, typename AT, typename L>
+    struct factorization_engine<dr_matrix_engine<T, AT, L>> { using type = dr_matrix_engine<T, AT, L>; };
+
+    template <typename ET>
+    using factorization_engine_t = typename factorization_engine<ET>::type;
+
+    /// Owning engine type for the solution of a linear system with right-hand side of engine type ET.
+    template <typename T, typename ET>
+    struct solution_engine {
+        using type = std::conditional_t<is_vector_engine_v<ET>, dr_vector_engine<T>, dr_matrix_engine<T>>;
+    };
+
+    template <typename T, typename T2, std::size_t N>
+    struct solution_engine<T, fs_vector_engine<T2, N>> { using type = fs_vector_engine<T, N>; };
+
+    template <typename T, typename T2, std::size_t R, std::size_t C, typename L>
+    struct solution_engine<T, fs_matrix_engine<T2, R, C, L>> { using type = fs_matrix_engine<T, R, C, L>; };
+
+    template <typename T, typename ET>
+    using solution_engine_t = typename solution_engine<T, ET>::type;
+
+    /// Storage for the row pivots of a factorization of a matrix with engine type ET.
+    template <typename ET>
+    struct pivot_storage { using type = std::vector<std::size_t>; };
+
+    template <typename T, std::size_t R, std::size_t C, typename L>
+    struct pivot_storage<fs_matrix_engine<T, R, C, L>> { using type = std::array<std::size_t, R>; };
+
+    /**
+     * Computes the determinant of a square matrix of integral element type with the fraction-free
+     * Bareiss elimination, which - unlike LU - keeps all intermediate values integral and exact.
+     */
+    template <typename ET, typename OT>
+    constexpr auto bareiss_det(matrix<ET, OT> m) -> typename ET::value_type
+    {
+        using value_type = typename ET::value_type;
+        using size_type = typename ET::size_type;
+
+        auto const n = m.rows();
+        auto sign = value_type(1);
+        auto previous = value_type(1);
+
+        for (size_type k = 0; k + 1 < n; ++k)
+        {
+            if (m(k, k) == value_type{})
+            {
+                size_type p = k + 1;
+                while (p < n && m(p, k) == value_type{})
+                    ++p;
+                if (p == n)
+                    return value_type{};
+                m.swap_rows(k, p);
+                sign = -sign;
+            }
+
+            for (size_type i = k + 1; i < n; ++i)
+                for (size_type j = k + 1; j < n; ++j)
+                    m(i, j) = (m(i, j) * m(k, k) - m(i, k) * m(k, j)) / previous;
+
+            previous = m(k, k);
+        }
+
+        return sign * m(n - 1, n - 1);
+    }
+} // }}}
+
+/**
+ * LU decomposition with partial (row) pivoting, P * A = L * U.
+ *
+ * The factors are stored packed into a single matrix, with the unit lower triangular L below
+ * and the upper triangular U on and above the diagonal. The row permutation P is stored as the
+ * sequence of row interchanges, i.e. row k was swapped with row pivots()[k] in step k.
+ *
+ * A factorization is computed once and can then be used to solve A * x = b for any number of
+ * right-hand sides, where solve_into() solves in place and never allocates.
+ */
+template <typename ET, typename OT = matrix_operation_traits>
+class lu_factorization {
+    static_assert(is_matrix_engine_v<ET> && !is_readonly_engine_v<ET>, "ET must be a writable matrix engine.");
+    static_assert(!std::is_integral_v<typename ET::value_type>,
+                  "LU factorization requires a field element type, such as floating point.");
+
+  public:
+    //- Types
+    //
+    using engine_type = ET;
+    using matrix_type = matrix<ET, OT>;
+    using value_type = typename engine_type::value_type;
+    using size_type = typename engine_type::size_type;
+    using pivot_type = typename detail::pivot_storage<ET>::type;
+
+    //- Construct/copy/destroy
+    //
+    template <typename ET2, typename OT2>
+    constexpr explicit lu_factorization(matrix<ET2, OT2> const& a) : lu_(a) { factorize(); }
+    // Resizable engines allocate their pivots, see factorize().
+    constexpr explicit lu_factorization(matrix_type&& a) noexcept(is_fixed_size_engine_v<ET>) :
+        lu_(std::move(a))
+    {
+        factorize();
+    }
+
+    //- Properties
+    //
+    constexpr size_type size() const noexcept { return lu_.rows(); }
+    constexpr bool is_singular() const noexcept { return singular_; }
+    constexpr matrix_type const& packed() const noexcept { return lu_; }
+    constexpr pivot_type const& pivots() const noexcept { return pivots_; }
+
+    /// Computes the determinant of the factorized matrix.
+    constexpr value_type det() const
+    {
+        auto d = swaps_ % 2 == 0 ? value_type(1) : value_type(-1);
+        for (size_type k = 0; k < size(); ++k)
+            d = d * lu_(k, k);
+        return d;
+    }
+
+    /// Computes the inverse of the factorized matrix.
+    constexpr matrix_type inverse() const
+    {
+        matrix_type x{};
+        if constexpr (is_resizable_engine_v<engine_type>)
+            x.resize(size(), size());
+
+        for (size_type k = 0; k < size(); ++k)
+            x(k, k) = value_type(1);
+
+        solve_into(x);
+        return x;
+    }
+
+    //- Solving
+    //
+    /// Solves A * x = b, overwriting b with the solution x.
+    template <typename ET2, typename OT2>
+    constexpr void solve_into(vector<ET2, OT2>& b) const
+    {
+        assert(b.size() == size());
+        ensure_regular();
+
+        auto const n = size();
+
+        for (size_type k = 0; k < n; ++k)
+            if (auto const p = pivots_[k]; p != k)
+            {
+                auto const t = b(k);
+                b(k) = b(p);
+                b(p) = t;
+            }
+
+        for (size_type i = 1; i < n; ++i)
+        {
+            auto v = b(i);
+            for (size_type k = 0; k < i; ++k)
+                v = v - lu_(i, k) * b(k);
+            b(i) = v;
+        }
+
+        for (size_type i = n; i-- > 0; )
+        {
+            auto v = b(i);
+            for (size_type k = i + 1; k < n; ++k)
+                v = v - lu_(i, k) * b(k);
+            b(i) = v / lu_(i, i);
+        }
+    }
+
+    /// Solves A * X = B for all columns of B at once, overwriting B with the solution X.
+    template <typename ET2, typename OT2>
+    constexpr void solve_into(matrix<ET2, OT2>& b) const
+    {
+        assert(b.rows() == size());
+        ensure_regular();
+
+        for (size_type k = 0; k < size(); ++k)
+            if (pivots_[k] != k)
+                b.swap_rows(k, pivots_[k]);
+
+        substitute(b);
+    }
+
+    // Overloads for solving into (writable) views, such as a matrix column.
+    template <typename ET2, typename OT2>
+    constexpr void solve_into(vector<ET2, OT2>&& b) const { solve_into(b); }
+    template <typename ET2, typename OT2>
+    constexpr void solve_into(matrix<ET2, OT2>&& b) const { solve_into(b); }
+
+    /// Solves A * x = b and returns x.
+    template <typename ET2, typename OT2>
+    constexpr auto solve(vector<ET2, OT2> const& b) const
+    {
+        auto x = vector<detail::solution_engine_t<value_type, ET2>, OT2>(b);
+        solve_into(x);
+        return x;
+    }
+
+    /// Solves A * X = B for a batch of right-hand sides, given as the columns of B, and returns X.
+    template <typename ET2, typename OT2>
+    constexpr auto solve(matrix<ET2, OT2> const& b) const
+    {
+        auto x = matrix<detail::solution_engine_t<value_type, ET2>, OT2>(b);
+        solve_into(x);
+        return x;
+    }
+
+  private:
+    constexpr void ensure_regular() const
+    {
+        if (singular_)
+            throw std::domain_error{"Given matrix is not invertible."};
+    }
+
+    constexpr void factorize()
+    {
+        auto const n = lu_.rows();
+        assert(n == lu_.columns());
+
+        if constexpr (is_resizable_engine_v<engine_type>)
+            pivots_.resize(n);
+
+        for (size_type k = 0; k < n; ++k)
+        {
+            size_type p = k;
+            auto largest = detail::magnitude(lu_(k, k));
+            for (size_type i = k + 1; i < n; ++i)
+                if (auto const v = detail::magnitude(lu_(i, k)); largest < v)
+                {
+                    p = i;
+                    largest = v;
+                }
+
+            pivots_[k] = p;
+            if (p != k)
+            {
+                lu_.swap_rows(k, p);
+                ++swaps_;
+            }
+
+            auto const pivot = lu_(k, k);
+            if (pivot == value_type{})
+            {
+                singular_ = true;
+                continue;
+            }
+
+            for (size_type i = k + 1; i < n; ++i)
+            {
+                auto const l = lu_(i, k) = lu_(i, k) / pivot;
+                for (size_type j = k + 1; j < n; ++j)
+                    lu_(i, j) = lu_(i, j) - l * lu_(k, j);
+            }
+        }
+    }
+
+    /// Solves L * U * X = B for all columns of B at once, overwriting B with X.
+    template <typename ET2, typename OT2>
+    constexpr void substitute(matrix<ET2, OT2>& b) const
+    {
+        auto const n = size();
+        auto const m = b.columns();
+
+        for (size_type i = 1; i < n; ++i)
+            for (size_type k = 0; k < i; ++k)
+                if (auto const l = lu_(i, k); l != value_type{})
+                    for (size_type j = 0; j < m; ++j)
+                        b(i, j) = b(i, j) - l * b(k, j);
+
+        for (size_type i = n; i-- > 0; )
+        {
+            for (size_type k = i + 1; k < n; ++k)
+                if (auto const u = lu_(i, k); u != value_type{})
+                    for (size_type j = 0; j < m; ++j)
+                        b(i, j) = b(i, j) - u * b(k, j);
+
+            auto const d = lu_(i, i);
+            for (size_type j = 0; j < m; ++j)
+                b(i, j) = b(i, j) / d;
+        }
+    }
+
+    matrix_type lu_;
+    pivot_type pivots_{};
+    size_type swaps_ = 0;
+    bool singular_ = false;
+};
+
+template <typename ET, typename OT>
+lu_factorization(matrix<ET, OT> const&) -> lu_factorization<detail::factorization_engine_t<ET>, OT>;
+
+template <typename ET, typename OT>
+lu_factorization(matrix<ET, OT>&&) -> lu_factorization<detail::factorization_engine_t<ET>, OT>;
+
+/// Solves the linear system A * x = b.
+///
+/// Use lu_factorization directly in order to solve the same system for more than one right-hand side.
+template <typename ET1, typename OT1, typename ET2, typename OT2>
+constexpr auto solve(matrix<ET1, OT1> const& a, vector<ET2, OT2> const& b)
+{
+    return lu_factorization(a).solve(b);
+}
+
+/// Solves the linear system A * X = B for all columns of B.
+template <typename ET1, typename OT1, typename ET2, typename OT2>
+constexpr auto solve(matrix<ET1, OT1> const& a, matrix<ET2, OT2> const& b)
+{
+    return lu_factorization(a).solve(b);
+}
+
+} // end namespace
@@ -21,12 +21,14 @@
 #include <algorithm>
 #include <cstdint>
 #include <initializer_list>
+#include <iterator>
 #include <list>
 #include <map>
 #include <numeric>
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
@@ -36,8 +38,10 @@ namespace backport // {{{ constexpr versions of some algorithms (for pre C++20)
     template <class ForwardIt1, class ForwardIt2>
     constexpr void iter_swap(ForwardIt1 a, ForwardIt2 b)
     {
-       using std::swap;
-       swap(*a, *b);
+       // std::swap is not constexpr before C++20 either
+       auto t = std::move(*a);
+       *a = std::move(*b);
+       *b = std::move(t);
     }
 
     template <class BidirIt>
@@ -96,6 +100,9 @@ template <std::size_t N> constexpr inline std::size_t factorial_v = factorial<N>
 template <std::size_t N>
 class permutation;
 
+template <std::size_t N>
+class permutation_range;
+
 // {{{ free functions
 template <std::size_t N>
 auto to_map(permutation<N> const& pi) -> std::map<typename permutation<N>::value_type,
@@ -290,13 +297,11 @@ class permutation {
         return permutation<N>();
     }
 
-    // Constructs a list of all permutations between 1 and n.
-    constexpr static std::array<permutation<N>, factorial_v<N>> all()
+    // Range of all permutations between 1 and n, generated lazily (in the order of Heap's algorithm),
+    // starting with the identity.
+    constexpr static permutation_range<N> all() noexcept
     {
-        std::array<permutation<N>, factorial_v<N>> r{};
-        for (size_t i = 1; i < factorial_v<N>; ++i)
-            ++(r[i] = r[i - 1]);
-        return r;
+        return permutation_range<N>{};
     }
 
     constexpr permutation& operator++() noexcept
@@ -309,6 +314,85 @@ class permutation {
     array_type values_{};
 };
 
+/**
+ * Lazy range of all N! permutations of 1..N, see permutation<N>::all().
+ *
+ * The permutations are generated by Heap's algorithm, i.e. each one from the previous one by a
+ * single transposition, in amortized O(1) per step. Only the current permutation is held by the
+ * iterator, and as consecutive permutations differ by one transposition, their signs alternate,
+ * which the iterator's sign() returns without counting inversions (see sgn()).
+ */
+template <std::size_t N>
+class permutation_range {
+  public:
+    using value_type = permutation<N>;
+    using size_type = std::size_t;
+
+    class iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = permutation<N>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = permutation<N> const*;
+        using reference = permutation<N> const&;
+
+        constexpr iterator() noexcept = default;
+        constexpr explicit iterator(std::size_t index) noexcept : index_{index} {}
+
+        constexpr reference operator*() const noexcept { return current_; }
+        constexpr pointer operator->() const noexcept { return &current_; }
+
+        // Sign of the current permutation, +1 if even, -1 if odd.
+        constexpr int sign() const noexcept { return index_ % 2 == 0 ? +1 : -1; }
+
+        constexpr iterator& operator++() noexcept
+        {
+            ++index_;
+            auto const a = current_.begin();
+            // finds the lowest level whose counter is not exhausted yet, resetting the ones below
+            while (level_ < N)
+            {
+                if (counters_[level_] < level_)
+                {
+                    if (level_ % 2 == 0)
+                        backport::iter_swap(a, a + level_);
+                    else
+                        backport::iter_swap(a + counters_[level_], a + level_);
+                    ++counters_[level_];
+                    level_ = 1;
+                    break;
+                }
+                counters_[level_] = 0;
+                ++level_;
+            }
+            return *this;
+        }
+
+        constexpr iterator operator++(int) noexcept
+        {
+            auto const old = *this;
+            ++*this;
+            return old;
+        }
+
+        constexpr bool operator==(iterator const& other) const noexcept { return index_ == other.index_; }
+        constexpr bool operator!=(iterator const& other) const noexcept { return index_ != other.index_; }
+
+      private:
+        std::size_t index_ = 0;
+        permutation<N> current_{};
+        std::array<std::size_t, N> counters_{};
+        std::size_t level_ = 1;
+    };
+
+    using const_iterator = iterator;
+
+    constexpr size_type size() const noexcept { return factorial_v<N>; }
+
+    constexpr iterator begin() const noexcept { return iterator{}; }
+    constexpr iterator end() const noexcept { return iterator{factorial_v<N>}; }
+};
+
 template <std::size_t N>
 constexpr bool operator==(permutation<N> const& a, permutation<N> const& b) noexcept
 {
@@ -0,0 +1,316 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+#include "execution.h"
+#include "ext_det.h"
+#include "fs_matrix_engine.h"
+#include "fs_vector_engine.h"
+#include "matrix.h"
+#include "simd.h"
+#include "span.h"
+#include "unrolled_kernel.h"
+#include "vector.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// EXT: Transforms of 3D points in homogeneous coordinates by 4x4 matrices.
+//
+// The points are streamed through one matrix at a time, instead of multiplying it with each
+// point as a vector of its own. The matrix is read once into locals (i.e. registers), and the loop
+// over the points is vectorized, transforming as many points per iteration as there are SIMD lanes.
+//
+// Affine and rigid transforms are inverted by their structure, inverting only their linear part.
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+/// EXT: Tag of transforms that may be projective, i.e. with any last row (the default).
+struct projective_t { explicit projective_t() = default; };
+constexpr inline projective_t projective{};
+
+/// EXT: Tag of affine transforms, i.e. whose last row is (0, 0, 0, 1), which is not computed then.
+struct affine_t { explicit affine_t() = default; };
+constexpr inline affine_t affine{};
+
+namespace detail { // {{{
+    template <typename Mode>
+    constexpr inline bool is_transform_mode_v = std::is_same_v<Mode, projective_t> || std::is_same_v<Mode, affine_t>;
+
+    /**
+     * Transforms the point p by a, writing its coordinates by out(i, value).
+     *
+     * Points of N = 3 coordinates are extended by w = 1, and the result is divided by its w again
+     * (unless affine). Points of N = 4 coordinates are transformed as they are, while affine
+     * transforms keep their w.
+     */
+    template <std::size_t N, typename Mode, typename T, typename Out>
+    constexpr void transform_point(T const (&a)[4][4], T const (&p)[N], Out&& out)
+    {
+        constexpr auto Rows = std::is_same_v<Mode, affine_t> ? 3 : 4;
+
+        T q[4];
+        unrolled<Rows>([&](auto i) {
+            auto ap = a[i][0] * p[0];
+            unrolled<N - 1>([&](auto j) { ap = ap + a[i][j + 1] * p[j + 1]; });
+            q[i] = N == 3 ? ap + a[i][3] : ap;
+        });
+
+        if constexpr (N == 3 && Rows == 4)
+        {
+            auto const s = T(1) / q[3];
+            unrolled<3>([&](auto i) { out(i, q[i] * s); });
+        }
+        else
+        {
+            unrolled<Rows>([&](auto i) { out(i, q[i]); });
+            if constexpr (N == 4 && Rows == 3)
+                out(3, p[3]);
+        }
+    }
+
+    /**
+     * Transforms the n points of the planes in into the planes out, i.e. coordinate j of point k is in[j][k].
+     *
+     * The loop is vectorized across the points, i.e. the coordinates of as many points as there
+     * are SIMD lanes are loaded at once. The planes of in and out must either be the same or not overlap.
+     */
+    template <std::size_t N, typename Mode, typename T>
+    void transform_planes(T const (&m)[4][4], std::size_t n, std::array<T const*, N> in, std::array<T*, N> out)
+    {
+        // local copy, as the points written might otherwise alias m, which would be reloaded then
+        T a[4][4];
+        unrolled<4, 4>([&](auto i, auto j) { a[i][j] = m[i][j]; });
+
+        LA_PRAGMA_UNSEQ
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            T p[N];
+            unrolled<N>([&](auto j) { p[j] = in[j][k]; });
+            transform_point<N, Mode>(a, p, [&](std::size_t i, T v) { out[i][k] = v; });
+        }
+    }
+
+    /**
+     * Transforms the points k in [begin, end), with in(k, j) and out(k, i) accessing their coordinates.
+     *
+     * Interleaved coordinates would have to be shuffled across the SIMD lanes in order to vectorize
+     * across the points, hence these are transformed one by one, vectorized across the rows of m.
+     */
+    template <std::size_t N, typename Mode, typename T, typename In, typename Out>
+    void transform_points(T const (&m)[4][4], std::size_t begin, std::size_t end, In const& in, Out const& out)
+    {
+        T a[4][4];
+        unrolled<4, 4>([&](auto i, auto j) { a[i][j] = m[i][j]; });
+
+        for (auto k = begin; k < end; ++k)
+        {
+            T p[N];
+            unrolled<N>([&](auto j) { p[j] = in(k, j); });
+            transform_point<N, Mode>(a, p, [&](std::size_t i, T v) { out(k, i) = v; });
+        }
+    }
+
+    /// Copies the elements of the 4x4 matrix m into the array r, as taken by the kernels above.
+    template <typename T, typename MT>
+    constexpr void load_transform(MT const& m, T (&r)[4][4])
+    {
+        unrolled<4, 4>([&](auto i, auto j) { r[i][j] = T(m(i, j)); });
+    }
+
+    /**
+     * Inverse [A^-1 -A^-1 t; 0 1] of the affine transform m = [A t; 0 1], with A^-1 given as ai(i, j).
+     *
+     * All elements are computed before the result is written, element by element in order, so
+     * that it need not be zeroed first and is not read back.
+     */
+    template <std::size_t N, typename T, typename L, typename OT, typename AI>
+    constexpr auto affine_inverse(matrix<fs_matrix_engine<T, N, N, L>, OT> const& m, AI const& ai)
+    {
+        constexpr auto K = N - 1;
+
+        T t[K] = {};
+        unrolled<K>([&](auto i) {
+            t[i] = ai(i, 0) * m(0, K);
+            unrolled<K - 1>([&](auto j) { t[i] = t[i] + ai(i, j + 1) * m(j + 1, K); });
+        });
+
+        auto r = matrix<fs_matrix_engine<T, N, N, L>, OT>(uninitialized);
+        unrolled<N, N>([&](auto i, auto j) {
+            if constexpr (decltype(i)::value == K)
+                r(i, j) = decltype(j)::value == K ? T(1) : T(0);
+            else if constexpr (decltype(j)::value == K)
+                r(i, j) = -t[i];
+            else
+                r(i, j) = ai(i, j);
+        });
+        return r;
+    }
+} // }}}
+
+/**
+ * EXT: Transforms the points of in by the 4x4 matrix m into out, see projective_t and affine_t.
+ *
+ * Each row of the spans is a point of 3 or 4 coordinates, i.e. an array of points (AoS) is a
+ * row-major span of row stride 3 or 4, and a structure of arrays (SoA), with all x coordinates
+ * followed by all y coordinates etc., is a column-major span. SoA is vectorized across the points,
+ * AoS (and any other strides) point by point across the rows of m.
+ *
+ * in and out must either be the same or not overlap.
+ */
+template <class ExecutionPolicy, typename T, typename L, typename OT, typename U, typename V, typename Mode = projective_t,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy> && detail::is_transform_mode_v<Mode>, int> = 0>
+void transform_points(ExecutionPolicy&& policy, matrix<fs_matrix_engine<T, 4, 4, L>, OT> const& m,
+                      matrix_span<U> in, matrix_span<V> out, Mode = Mode{})
+{
+    static_assert(std::is_same_v<std::remove_cv_t<U>, T> && std::is_same_v<V, T>,
+                  "Points must be of the element type of the transform.");
+
+    assert(in.rows() == out.rows() && in.columns() == out.columns());
+    assert(in.columns() == 3 || in.columns() == 4);
+
+    T mt[4][4];
+    detail::load_transform(m, mt);
+
+    auto const run = [&](auto dim) {
+        constexpr auto N = decltype(dim)::value;
+        auto const kernel = [&](auto const& pin, auto const& pout) {
+            detail::simd::for_chunks<T>(policy, in.rows(), [&](std::size_t begin, std::size_t end) {
+                detail::transform_points<N, Mode>(mt, begin, end, pin, pout);
+            });
+        };
+
+        if (in.is_row_major() && in.row_stride() == N && out.is_row_major() && out.row_stride() == N)
+        {
+            // AoS, of compile-time stride
+            auto const pin = in.data();
+            auto const pout = out.data();
+            kernel([pin](std::size_t k, std::size_t j) -> U& { return pin[k * N + j]; },
+                   [pout](std::size_t k, std::size_t i) -> V& { return pout[k * N + i]; });
+        }
+        else if (in.is_column_major() && out.is_column_major())
+        {
+            // SoA, one contiguous array per coordinate
+            auto pin = std::array<T const*, N>{};
+            auto pout = std::array<T*, N>{};
+            for (auto j : detail::times(N))
+            {
+                pin[j] = in.data() + j * in.column_stride();
+                pout[j] = out.data() + j * out.column_stride();
+            }
+            detail::simd::for_chunks<T>(policy, in.rows(), [&](std::size_t begin, std::size_t end) {
+                auto const offset = [begin](auto planes) {
+                    for (auto& p : planes)
+                        p += begin;
+                    return planes;
+                };
+                detail::transform_planes<N, Mode>(mt, end - begin, offset(pin), offset(pout));
+            });
+        }
+        else
+            kernel(in, out);
+    };
+
+    if (in.columns() == 3)
+        run(std::integral_constant<std::size_t, 3>{});
+    else
+        run(std::integral_constant<std::size_t, 4>{});
+}
+
+/// EXT: Transforms the points of in by the 4x4 matrix m into out, which is resized to the size of in.
+template <class ExecutionPolicy, typename T, typename L, typename OT, std::size_t N, typename OT1, typename A1,
+          typename OT2, typename A2, typename Mode = projective_t,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy> && detail::is_transform_mode_v<Mode>, int> = 0>
+void transform_points(ExecutionPolicy&& policy, matrix<fs_matrix_engine<T, 4, 4, L>, OT> const& m,
+                      std::vector<vector<fs_vector_engine<T, N>, OT1>, A1> const& in,
+                      std::vector<vector<fs_vector_engine<T, N>, OT2>, A2>& out, Mode = Mode{})
+{
+    static_assert(N == 3 || N == 4, "Points must be of 3 or 4 (homogeneous) coordinates.");
+
+    out.resize(in.size());
+
+    T mt[4][4];
+    detail::load_transform(m, mt);
+
+    auto const pin = in.data();
+    auto const pout = out.data();
+    detail::simd::for_chunks<T>(policy, in.size(), [&](std::size_t begin, std::size_t end) {
+        detail::transform_points<N, Mode>(mt, begin, end,
+                                          [pin](std::size_t k, std::size_t j) -> T const& { return pin[k](j); },
+                                          [pout](std::size_t k, std::size_t i) -> T& { return pout[k](i); });
+    });
+}
+
+/**
+ * EXT: Computes the inverse of the affine transform m of 2D (3x3) or 3D (4x4) homogeneous coordinates.
+ *
+ * The last row of m is assumed to be (0, ..., 0, 1), and is not read. With m = [A t; 0 1], the
+ * inverse is [A^-1 -A^-1 t; 0 1], i.e. only A is inverted (in closed form).
+ *
+ * @throws std::domain_error if A is singular.
+ */
+template <typename T, std::size_t N, typename L, typename OT>
+constexpr auto inverse_affine(matrix<fs_matrix_engine<T, N, N, L>, OT> const& m)
+{
+    static_assert(N == 3 || N == 4, "Affine transforms are of 2D or 3D homogeneous coordinates.");
+    constexpr auto K = N - 1;
+
+    T a[K][K] = {};
+    auto const d = detail::closed_form_adjugate<K, T>(m, [&](std::size_t i, std::size_t j) -> T& { return a[i][j]; });
+    if (d == T{})
+        detail::throw_not_invertible();
+
+    auto const s = T(1) / d;
+    return detail::affine_inverse(m, [&](std::size_t i, std::size_t j) { return s * a[i][j]; });
+}
+
+/**
+ * EXT: Computes the inverse of the rigid transform m of 2D (3x3) or 3D (4x4) homogeneous coordinates.
+ *
+ * m = [R t; 0 1] must be affine, with R orthonormal (a rotation, possibly with reflection), which
+ * is not checked. Its inverse is [R^T -R^T t; 0 1], i.e. no division is involved.
+ */
+template <typename T, std::size_t N, typename L, typename OT>
+constexpr auto inverse_rigid(matrix<fs_matrix_engine<T, N, N, L>, OT> const& m)
+{
+    static_assert(N == 3 || N == 4, "Rigid transforms are of 2D or 3D homogeneous coordinates.");
+
+    return detail::affine_inverse(m, [&](std::size_t i, std::size_t j) { return m(j, i); });
+}
+
+//- Overloads with the execution policy of the transform's operation traits.
+//
+template <typename T, typename L, typename OT, typename U, typename V, typename Mode = projective_t,
+          std::enable_if_t<detail::is_transform_mode_v<Mode>, int> = 0>
+void transform_points(matrix<fs_matrix_engine<T, 4, 4, L>, OT> const& m, matrix_span<U> in, matrix_span<V> out, Mode mode = Mode{})
+{
+    transform_points(execution_policy_t<OT>{}, m, in, out, mode);
+}
+
+template <typename T, typename L, typename OT, std::size_t N, typename OT1, typename A1, typename OT2, typename A2,
+          typename Mode = projective_t, std::enable_if_t<detail::is_transform_mode_v<Mode>, int> = 0>
+void transform_points(matrix<fs_matrix_engine<T, 4, 4, L>, OT> const& m,
+                      std::vector<vector<fs_vector_engine<T, N>, OT1>, A1> const& in,
+                      std::vector<vector<fs_vector_engine<T, N>, OT2>, A2>& out, Mode mode = Mode{})
+{
+    transform_points(execution_policy_t<OT>{}, m, in, out, mode);
+}
+
+} // end namespace
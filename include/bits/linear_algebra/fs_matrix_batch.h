@@ -0,0 +1,417 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "allocator.h"
+#include "base.h"
+#include "execution.h"
+#include "ext_det.h"
+#include "fs_matrix_engine.h"
+#include "matrix.h"
+#include "simd.h"
+#include "span.h"
+#include "support.h"
+#include "unrolled_kernel.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// EXT: Batches of many small matrices of the same fixed size, in structure-of-arrays order.
+//
+// Operating on one small matrix at a time leaves most lanes of the SIMD registers idle
+// (a 3x3 matrix fills neither 4 nor 8 lanes), and its closed forms are chains of dependent
+// operations. Instead, a batch stores element (i, j) of all of its K matrices contiguously
+// (a plane), so that the batched operations below compute the same closed form for as many
+// matrices at once as there are SIMD lanes, by running down the planes.
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+/**
+ * EXT: A batch of K matrices of R x C elements of type T, stored in structure-of-arrays order.
+ *
+ * The R * C planes are stored row by row, each plane padded to the leading dimension stride()
+ * (see detail::padded_leading_dimension), so that the planes start on cache lines of their own,
+ * given aligned storage (see aligned_allocator), and do not alias each other in the L1 cache.
+ *
+ * The layout L is the one of the matrices taken out of and put into the batch (see get()), the
+ * planes themselves are ordered row by row regardless.
+ */
+template <typename T, std::size_t R, std::size_t C, typename AT = std::allocator<T>, typename L = row_major>
+class fs_matrix_batch
+{
+    static_assert(R >= 1 && C >= 1, "Row and column count must be at least one.");
+    static_assert(is_matrix_element_v<T>, "Element type must be an arithmetic field type.");
+    static_assert(is_matrix_layout_v<L>, "Layout must be row_major or column_major.");
+
+  public:
+    using value_type = T;
+    using layout_type = L;
+    using allocator_type = AT;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using matrix_type = matrix<fs_matrix_engine<T, R, C, L>>;
+    using span_type = matrix_span<T>;
+    using const_span_type = matrix_span<T const>;
+
+    fs_matrix_batch() = default;
+
+    /// Constructs a batch of count zero matrices.
+    explicit fs_matrix_batch(size_type count) : fs_matrix_batch(uninitialized, count)
+    {
+        for (auto& e : elements_)
+            e = T{};
+    }
+
+    /// Constructs a batch of count matrices with indeterminate elements, see uninitialized_t.
+    fs_matrix_batch(uninitialized_t, size_type count) :
+        elements_(R * C * detail::padded_leading_dimension<T>(count)),
+        count_{count},
+        stride_{detail::padded_leading_dimension<T>(count)}
+    {}
+
+    static constexpr size_type rows() noexcept { return R; }
+    static constexpr size_type columns() noexcept { return C; }
+
+    /// Number of matrices in the batch.
+    size_type size() const noexcept { return count_; }
+
+    /// Distance of the planes in elements.
+    size_type stride() const noexcept { return stride_; }
+
+    /// Element (i, j) of matrix k.
+    reference operator()(size_type k, size_type i, size_type j) { return plane(i, j)[k]; }
+    const_reference operator()(size_type k, size_type i, size_type j) const { return plane(i, j)[k]; }
+
+    /// The elements (i, j) of all matrices, i.e. size() contiguous elements.
+    T* plane(size_type i, size_type j) noexcept
+    {
+        assert(i < R && j < C);
+        return elements_.data() + (i * C + j) * stride_;
+    }
+
+    T const* plane(size_type i, size_type j) const noexcept
+    {
+        assert(i < R && j < C);
+        return elements_.data() + (i * C + j) * stride_;
+    }
+
+    /// View of matrix k, strided across the planes.
+    span_type span(size_type k) noexcept
+    {
+        assert(k < count_);
+        return span_type(elements_.data() + k, R, C, C * stride_, stride_);
+    }
+
+    const_span_type span(size_type k) const noexcept
+    {
+        assert(k < count_);
+        return const_span_type(elements_.data() + k, R, C, C * stride_, stride_);
+    }
+
+    /// Copy of matrix k.
+    matrix_type get(size_type k) const
+    {
+        assert(k < count_);
+        auto m = matrix_type(uninitialized);
+        detail::unrolled<R, C>([&](auto i, auto j) { m(i, j) = plane(i, j)[k]; });
+        return m;
+    }
+
+    /// Assigns the R x C matrix m to matrix k.
+    template <typename ET, typename OT>
+    void set(size_type k, matrix<ET, OT> const& m)
+    {
+        assert(k < count_ && m.rows() == R && m.columns() == C);
+        detail::unrolled<R, C>([&](auto i, auto j) { plane(i, j)[k] = T(m(i, j)); });
+    }
+
+  private:
+    std::vector<T, detail::default_init_allocator_t<T, AT>> elements_;
+    size_type count_ = 0;
+    size_type stride_ = 0;
+};
+
+namespace detail { // {{{
+    /**
+     * The plane pointers of a batch, taken once ahead of the loops over the batch, so that the
+     * compiler need not reload them from the batch after each store into one of its planes.
+     */
+    template <typename P, std::size_t R, std::size_t C>
+    struct batch_planes {
+        std::array<P, R * C> planes;
+
+        template <typename B>
+        explicit batch_planes(B& batch)
+        {
+            for (auto [i, j] : times(R) * times(C))
+                planes[i * C + j] = batch.plane(i, j);
+        }
+
+        /// Element (i, j) of matrix k, which is indexable as m(i, j) by the closed forms, see element().
+        constexpr auto& operator()(std::size_t k, std::size_t i, std::size_t j) const { return planes[i * C + j][k]; }
+
+        constexpr auto element(std::size_t k) const
+        {
+            return [this, k](std::size_t i, std::size_t j) -> auto& { return (*this)(k, i, j); };
+        }
+    };
+
+    template <typename T, std::size_t R, std::size_t C, typename AT, typename L>
+    batch_planes(fs_matrix_batch<T, R, C, AT, L>&) -> batch_planes<T*, R, C>;
+
+    template <typename T, std::size_t R, std::size_t C, typename AT, typename L>
+    batch_planes(fs_matrix_batch<T, R, C, AT, L> const&) -> batch_planes<T const*, R, C>;
+
+    /**
+     * 1 / d, for the determinant d of a matrix of a batch.
+     *
+     * Singular matrices are reported once the whole batch is done, hence floating-point
+     * determinants are divided by unconditionally (yielding infinities if zero), as a conditional
+     * division would keep the loop from being vectorized. Integers must not be divided by zero.
+     */
+    template <typename T>
+    constexpr T batch_reciprocal(T d)
+    {
+        if constexpr (std::is_integral_v<T>)
+            return d == T{} ? T{} : T(1) / d;
+        else
+            return T(1) / d;
+    }
+
+    /**
+     * Invokes kernel(k) for all matrices k of a batch of size n, in chunks of the policy.
+     *
+     * The matrices are independent of one another by construction, hence the loop is vectorized
+     * across the batch, computing the kernel for consecutive k in the lanes of the SIMD registers.
+     */
+    template <typename T, typename ExecutionPolicy, typename Kernel>
+    void for_each_in_batch(ExecutionPolicy policy, std::size_t n, Kernel const& kernel)
+    {
+        simd::for_chunks<T>(policy, n, [&](std::size_t begin, std::size_t end) {
+            LA_PRAGMA_UNSEQ
+            for (auto k = begin; k < end; ++k)
+                kernel(k);
+        });
+    }
+
+    /**
+     * As for_each_in_batch(), for kernels returning the determinant of matrix k. Returns whether
+     * any of them is zero, i.e. whether any of the matrices is singular.
+     *
+     * The determinants of a block of matrices are kept on the stack and scanned once the block is
+     * done, as testing them within the loop would keep it from being vectorized.
+     */
+    template <typename T, typename ExecutionPolicy, typename Kernel>
+    bool any_singular_in_batch(ExecutionPolicy policy, std::size_t n, Kernel const& kernel)
+    {
+        constexpr std::size_t block = 256;
+        auto singular = std::atomic<bool>{false};
+        simd::for_chunks<T>(policy, n, [&](std::size_t begin, std::size_t end) {
+            T d[block];
+            auto any = false;
+            for (auto first = begin; first < end; first += block)
+            {
+                auto const m = std::min(block, end - first);
+                LA_PRAGMA_UNSEQ
+                for (std::size_t k = 0; k < m; ++k)
+                    d[k] = kernel(first + k);
+                for (std::size_t k = 0; k < m; ++k)
+                    any |= d[k] == T{};
+            }
+            if (any)
+                singular.store(true, std::memory_order_relaxed);
+        });
+        return singular.load(std::memory_order_relaxed);
+    }
+} // }}}
+
+/// EXT: C_k = A_k B_k for all matrices k of the batches, into the batch c of the same size,
+/// which must be neither a nor b.
+template <class ExecutionPolicy, typename T, std::size_t R, std::size_t K, std::size_t C, typename AT, typename L,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+void multiply_into(ExecutionPolicy&& policy, fs_matrix_batch<T, R, K, AT, L> const& a,
+                   fs_matrix_batch<T, K, C, AT, L> const& b, fs_matrix_batch<T, R, C, AT, L>& c)
+{
+    assert(a.size() == b.size() && c.size() == a.size());
+
+    auto const pa = detail::batch_planes(a);
+    auto const pb = detail::batch_planes(b);
+    auto const pc = detail::batch_planes(c);
+    detail::for_each_in_batch<T>(policy, a.size(), [&](std::size_t k) {
+        detail::unrolled<R, C>([&](auto i, auto j) {
+            pc(k, i, j) = detail::unrolled_sum<T, K>([&](auto q) { return pa(k, i, q) * pb(k, q, j); });
+        });
+    });
+}
+
+/// EXT: C_k = A_k B_k for all matrices k of the batches.
+template <class ExecutionPolicy, typename T, std::size_t R, std::size_t K, std::size_t C, typename AT, typename L,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+auto multiply(ExecutionPolicy&& policy, fs_matrix_batch<T, R, K, AT, L> const& a, fs_matrix_batch<T, K, C, AT, L> const& b)
+{
+    auto c = fs_matrix_batch<T, R, C, AT, L>(uninitialized, a.size());
+    multiply_into(policy, a, b, c);
+    return c;
+}
+
+/// EXT: The determinants of all matrices of the batch, in closed form.
+template <class ExecutionPolicy, typename T, std::size_t N, typename AT, typename L,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+auto det(ExecutionPolicy&& policy, fs_matrix_batch<T, N, N, AT, L> const& a)
+{
+    static_assert(N <= 4, "Batched determinants are computed in closed form, i.e. of up to 4x4 matrices.");
+
+    auto d = std::vector<T, AT>(a.size());
+    auto const pa = detail::batch_planes(a);
+    auto* const pd = d.data();
+    detail::for_each_in_batch<T>(policy, a.size(), [&](std::size_t k) {
+        pd[k] = detail::closed_form_det<N, T>(pa.element(k));
+    });
+    return d;
+}
+
+/// EXT: The inverses of all matrices of the batch, in closed form, into the batch r of the same
+/// size, which may be a itself.
+///
+/// @throws std::domain_error if any of the matrices is singular, once all of r is written.
+template <class ExecutionPolicy, typename T, std::size_t N, typename AT, typename L,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+void inverse_into(ExecutionPolicy&& policy, fs_matrix_batch<T, N, N, AT, L> const& a, fs_matrix_batch<T, N, N, AT, L>& r)
+{
+    static_assert(2 <= N && N <= 4, "Batched inverses are computed in closed form, i.e. of 2x2 up to 4x4 matrices.");
+    assert(r.size() == a.size());
+
+    auto const pa = detail::batch_planes(a);
+    auto const pr = detail::batch_planes(r);
+    auto const singular = detail::any_singular_in_batch<T>(policy, a.size(), [&](std::size_t k) {
+        // the adjugate of A_k is kept in registers, i.e. A_k is read entirely before R_k is written
+        T adj[N][N];
+        auto const d = detail::closed_form_adjugate<N, T>(pa.element(k), [&](std::size_t i, std::size_t j) -> T& { return adj[i][j]; });
+        auto const s = detail::batch_reciprocal(d);
+        detail::unrolled<N, N>([&](auto i, auto j) { pr(k, i, j) = s * adj[i][j]; });
+        return d;
+    });
+
+    if (singular)
+        detail::throw_not_invertible();
+}
+
+/// EXT: The inverses of all matrices of the batch, in closed form.
+///
+/// @throws std::domain_error if any of the matrices is singular.
+template <class ExecutionPolicy, typename T, std::size_t N, typename AT, typename L,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+auto inverse(ExecutionPolicy&& policy, fs_matrix_batch<T, N, N, AT, L> const& a)
+{
+    auto r = fs_matrix_batch<T, N, N, AT, L>(uninitialized, a.size());
+    inverse_into(policy, a, r);
+    return r;
+}
+
+/// EXT: X_k = inverse(A_k) B_k for all matrices k of the batches, i.e. the solutions of A_k X_k = B_k,
+/// into the batch x of the same size, which must be neither a nor b.
+///
+/// @throws std::domain_error if any of the matrices A_k is singular, once all of x is written.
+template <class ExecutionPolicy, typename T, std::size_t N, std::size_t M, typename AT, typename L,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+void solve_into(ExecutionPolicy&& policy, fs_matrix_batch<T, N, N, AT, L> const& a,
+                fs_matrix_batch<T, N, M, AT, L> const& b, fs_matrix_batch<T, N, M, AT, L>& x)
+{
+    static_assert(2 <= N && N <= 4, "Batched systems are solved in closed form, i.e. of 2x2 up to 4x4 matrices.");
+    assert(a.size() == b.size() && x.size() == a.size());
+
+    auto const pa = detail::batch_planes(a);
+    auto const pb = detail::batch_planes(b);
+    auto const px = detail::batch_planes(x);
+    auto const singular = detail::any_singular_in_batch<T>(policy, a.size(), [&](std::size_t k) {
+        T adj[N][N];
+        auto const d = detail::closed_form_adjugate<N, T>(pa.element(k), [&](std::size_t i, std::size_t j) -> T& { return adj[i][j]; });
+        auto const s = detail::batch_reciprocal(d);
+        detail::unrolled<N, M>([&](auto i, auto j) {
+            px(k, i, j) = s * detail::unrolled_sum<T, N>([&](auto q) { return adj[i][q] * pb(k, q, j); });
+        });
+        return d;
+    });
+
+    if (singular)
+        detail::throw_not_invertible();
+}
+
+/// EXT: X_k = inverse(A_k) B_k for all matrices k of the batches, i.e. the solutions of A_k X_k = B_k.
+///
+/// @throws std::domain_error if any of the matrices A_k is singular.
+template <class ExecutionPolicy, typename T, std::size_t N, std::size_t M, typename AT, typename L,
+          std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+auto solve(ExecutionPolicy&& policy, fs_matrix_batch<T, N, N, AT, L> const& a, fs_matrix_batch<T, N, M, AT, L> const& b)
+{
+    auto x = fs_matrix_batch<T, N, M, AT, L>(uninitialized, a.size());
+    solve_into(policy, a, b, x);
+    return x;
+}
+
+//- Overloads with the sequenced (vectorized) execution policy.
+//
+template <typename T, std::size_t R, std::size_t K, std::size_t C, typename AT, typename L>
+auto multiply(fs_matrix_batch<T, R, K, AT, L> const& a, fs_matrix_batch<T, K, C, AT, L> const& b)
+{
+    return multiply(execution::seq, a, b);
+}
+
+template <typename T, std::size_t N, typename AT, typename L>
+auto det(fs_matrix_batch<T, N, N, AT, L> const& a)
+{
+    return det(execution::seq, a);
+}
+
+template <typename T, std::size_t N, typename AT, typename L>
+auto inverse(fs_matrix_batch<T, N, N, AT, L> const& a)
+{
+    return inverse(execution::seq, a);
+}
+
+template <typename T, std::size_t N, std::size_t M, typename AT, typename L>
+auto solve(fs_matrix_batch<T, N, N, AT, L> const& a, fs_matrix_batch<T, N, M, AT, L> const& b)
+{
+    return solve(execution::seq, a, b);
+}
+
+template <typename T, std::size_t R, std::size_t K, std::size_t C, typename AT, typename L>
+void multiply_into(fs_matrix_batch<T, R, K, AT, L> const& a, fs_matrix_batch<T, K, C, AT, L> const& b,
+                   fs_matrix_batch<T, R, C, AT, L>& c)
+{
+    multiply_into(execution::seq, a, b, c);
+}
+
+template <typename T, std::size_t N, typename AT, typename L>
+void inverse_into(fs_matrix_batch<T, N, N, AT, L> const& a, fs_matrix_batch<T, N, N, AT, L>& r)
+{
+    inverse_into(execution::seq, a, r);
+}
+
+template <typename T, std::size_t N, std::size_t M, typename AT, typename L>
+void solve_into(fs_matrix_batch<T, N, N, AT, L> const& a, fs_matrix_batch<T, N, M, AT, L> const& b,
+                fs_matrix_batch<T, N, M, AT, L>& x)
+{
+    solve_into(execution::seq, a, b, x);
+}
+
+} // end namespace
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "base.h"
+#include "span.h"
 
 #include <cassert>
 
@@ -27,16 +28,24 @@
 namespace LINEAR_ALGEBRA_NAMESPACE {
 
 // 6.4.4 | class fs_matrix_engine<T, R, C>
-template <class T, size_t R, size_t C>
-class fs_matrix_engine : public matrix_engine<fs_matrix_engine<T, R, C>>
+//
+// EXT: the elements are stored in the layout L, i.e. row_major or column_major (see base.h).
+template <class T, size_t R, size_t C, class L>
+class fs_matrix_engine : public matrix_engine<fs_matrix_engine<T, R, C, L>>
 {
     static_assert(R >= 1 && C >= 1, "Row and column count must be at least one.");
     static_assert(is_matrix_element_v<T>, "Element type must be an arithmetic field type.");
+    static_assert(is_matrix_layout_v<L>, "Layout must be row_major or column_major.");
+
+    template <class, size_t, size_t, class> friend class fs_matrix_engine;
+
+    static constexpr bool is_column_major = std::is_same_v<L, column_major>;
 
   public:
     //- Types
     //
     using engine_category = writable_matrix_engine_tag;
+    using layout_type = L; // EXT
     using element_type = T;
     using value_type = std::remove_cv_t<T>;
     using pointer = element_type*;
@@ -46,18 +55,26 @@ class fs_matrix_engine : public matrix_engine<fs_matrix_engine<T, R, C>>
     using difference_type = std::ptrdiff_t;
     using size_type = std::size_t;
     using size_tuple = std::tuple<size_type, size_type>;
+    using span_type = matrix_span<element_type>;
+    using const_span_type = matrix_span<element_type const>;
 
     //- Construct/copy/destroy
     //
     ~fs_matrix_engine() noexcept = default;
-    constexpr fs_matrix_engine() = default;
+    constexpr fs_matrix_engine() : values_{} {}
+    /// EXT: leaves all elements indeterminate, see uninitialized_t.
+    constexpr explicit fs_matrix_engine(uninitialized_t) noexcept LA_UNINITIALIZED_MEMBER(values_) {}
 
+    /// Elements in row-major order, whatever the layout.
     template <typename U>
-    constexpr fs_matrix_engine(std::initializer_list<U> _values)
+    constexpr fs_matrix_engine(std::initializer_list<U> _values) : values_{}
     {
         size_t i = 0;
         for (auto v : _values)
-            values_[i++] = v;
+        {
+            values_[offset(i / C, i % C)] = v;
+            ++i;
+        }
         //TODO(constexpr) std::copy(std::begin(_values), std::end(_values), std::begin(values_));
     }
     constexpr fs_matrix_engine(fs_matrix_engine&&) noexcept = default;
@@ -91,12 +108,39 @@ class fs_matrix_engine : public matrix_engine<fs_matrix_engine<T, R, C>>
     //
     constexpr reference operator()(size_type i, size_type j)
     {
-        return values_[i * column_capacity() + j];
+        return values_[offset(i, j)];
     }
 
     constexpr const_reference operator()(size_type i, size_type j) const
     {
-        return values_[i * column_capacity() + j];
+        return values_[offset(i, j)];
+    }
+
+    //- Data access
+    //
+    constexpr pointer data() noexcept { return values_.data(); }
+    constexpr const_pointer data() const noexcept { return values_.data(); }
+    constexpr span_type span() noexcept
+    {
+        if constexpr (is_column_major)
+            return span_type(data(), R, C, 1, R);
+        else
+            return span_type(data(), R, C, C);
+    }
+    constexpr const_span_type span() const noexcept
+    {
+        if constexpr (is_column_major)
+            return const_span_type(data(), R, C, 1, R);
+        else
+            return const_span_type(data(), R, C, C);
+    }
+
+    /// EXT: the transpose of this matrix, which is its storage as is, read in the other layout.
+    constexpr fs_matrix_engine<T, C, R, detail::transposed_layout_t<L>> transposed() && noexcept
+    {
+        fs_matrix_engine<T, C, R, detail::transposed_layout_t<L>> t(uninitialized);
+        t.values_ = values_;
+        return t;
     }
 
     //- Modifiers
@@ -118,7 +162,15 @@ class fs_matrix_engine : public matrix_engine<fs_matrix_engine<T, R, C>>
     }
 
   private:
-    std::array<T, R * C> values_{};
+    static constexpr size_type offset(size_type i, size_type j) noexcept
+    {
+        if constexpr (is_column_major)
+            return j * R + i;
+        else
+            return i * C + j;
+    }
+
+    std::array<T, R * C> values_;
 };
 
 } // end namespace
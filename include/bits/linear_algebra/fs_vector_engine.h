@@ -15,6 +15,7 @@
 #pragma once
 
 #include "base.h"
+#include "span.h"
 
 #include <cassert>
 
@@ -29,7 +30,7 @@ namespace LINEAR_ALGEBRA_NAMESPACE {
 template <class T, size_t N>
 class fs_vector_engine {
   private:
-    std::array<T, N> values_{};
+    std::array<T, N> values_;
 
   public:
     using engine_category = writable_vector_engine_tag;
@@ -43,15 +44,19 @@ class fs_vector_engine {
     using size_type = size_t;
     using iterator = decltype(std::begin(values_));
     using const_iterator = decltype(std::cbegin(values_));
+    using span_type = vector_span<element_type>;
+    using const_span_type = vector_span<element_type const>;
 
     //- Construct/copy/destroy
     //
     ~fs_vector_engine() noexcept = default;
-    constexpr fs_vector_engine() = default;
+    constexpr fs_vector_engine() : values_{} {}
+    /// EXT: leaves all elements indeterminate, see uninitialized_t.
+    constexpr explicit fs_vector_engine(uninitialized_t) noexcept LA_UNINITIALIZED_MEMBER(values_) {}
     constexpr fs_vector_engine(fs_vector_engine&&) noexcept = default;
     constexpr fs_vector_engine(fs_vector_engine const&) = default;
     template <class U>
-    constexpr fs_vector_engine(std::initializer_list<U> list)
+    constexpr fs_vector_engine(std::initializer_list<U> list) : values_{}
     {
         std::size_t i = 0;
         for (auto && v : list)
@@ -79,6 +84,13 @@ class fs_vector_engine {
     constexpr reference operator()(size_type i) { return values_[i]; }
     constexpr const_reference operator()(size_type i) const { return values_[i]; }
 
+    //- Data access
+    //
+    constexpr pointer data() noexcept { return values_.data(); }
+    constexpr const_pointer data() const noexcept { return values_.data(); }
+    constexpr span_type span() noexcept { return span_type(data(), N); }
+    constexpr const_span_type span() const noexcept { return const_span_type(data(), N); }
+
     //- Modifiers
     //
     constexpr void swap(fs_vector_engine& rhs) noexcept { std::swap(values_, rhs.values_); }
@@ -0,0 +1,238 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+#include "execution.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace LINEAR_ALGEBRA_NAMESPACE::detail {
+
+/**
+ * Cache blocking parameters for the GEMM kernel.
+ *
+ * The micro-kernel keeps an MR x NR tile of C in registers, a packed MC x KC block of A
+ * is meant to stay in L2 and a packed KC x NC panel of B in L3.
+ */
+template <typename T>
+struct gemm_blocking {
+    static constexpr std::size_t MR = 4;
+    static constexpr std::size_t NR = std::clamp<std::size_t>(64 / sizeof(T), 4, 16);
+    static constexpr std::size_t KC = 256;
+    static constexpr std::size_t MC = 32 * MR;
+    static constexpr std::size_t NC = 256 * NR;
+};
+
+/// Packs the mc x kc block of A (scaled by alpha) into row panels of height MR.
+///
+/// The loop order follows the layout of A, so that A is read sequentially whether it is
+/// row-major (A * B, A * B^T) or column-major, i.e. a transposed row-major matrix (A^T * B).
+template <typename T, std::size_t MR>
+void gemm_pack_a(std::size_t mc, std::size_t kc, T alpha,
+                 T const* a, std::size_t rsa, std::size_t csa,
+                 T* buffer)
+{
+    for (std::size_t ip = 0; ip < mc; ip += MR, buffer += MR * kc)
+    {
+        std::size_t const mr = std::min(MR, mc - ip);
+        if (csa == 1 && rsa != 1)
+        {
+            for (std::size_t i = 0; i < mr; ++i)
+                for (std::size_t p = 0; p < kc; ++p)
+                    buffer[p * MR + i] = alpha * a[(ip + i) * rsa + p];
+        }
+        else
+        {
+            for (std::size_t p = 0; p < kc; ++p)
+                for (std::size_t i = 0; i < mr; ++i)
+                    buffer[p * MR + i] = alpha * a[(ip + i) * rsa + p * csa];
+        }
+        for (std::size_t p = 0; p < kc; ++p)
+            for (std::size_t i = mr; i < MR; ++i)
+                buffer[p * MR + i] = T{};
+    }
+}
+
+/// Packs the kc x nc panel of B into column panels of width NR.
+///
+/// As with gemm_pack_a(), B is read sequentially if it is row-major or column-major (A * B^T).
+template <typename T, std::size_t NR>
+void gemm_pack_b(std::size_t kc, std::size_t nc,
+                 T const* b, std::size_t rsb, std::size_t csb,
+                 T* buffer)
+{
+    for (std::size_t jp = 0; jp < nc; jp += NR, buffer += NR * kc)
+    {
+        std::size_t const nr = std::min(NR, nc - jp);
+        if (rsb == 1 && csb != 1)
+        {
+            for (std::size_t j = 0; j < nr; ++j)
+                for (std::size_t p = 0; p < kc; ++p)
+                    buffer[p * NR + j] = b[p + (jp + j) * csb];
+        }
+        else
+        {
+            for (std::size_t p = 0; p < kc; ++p)
+                for (std::size_t j = 0; j < nr; ++j)
+                    buffer[p * NR + j] = b[p * rsb + (jp + j) * csb];
+        }
+        for (std::size_t p = 0; p < kc; ++p)
+            for (std::size_t j = nr; j < NR; ++j)
+                buffer[p * NR + j] = T{};
+    }
+}
+
+/// Register micro-kernel: C[0..mr, 0..nr] += A_panel * B_panel.
+template <typename T, std::size_t MR, std::size_t NR>
+void gemm_micro_kernel(std::size_t kc, T const* a, T const* b,
+                       std::size_t mr, std::size_t nr,
+                       T* c, std::size_t rsc, std::size_t csc)
+{
+    T ab[MR][NR] = {};
+
+    for (std::size_t p = 0; p < kc; ++p, a += MR, b += NR)
+        for (std::size_t i = 0; i < MR; ++i)
+            for (std::size_t j = 0; j < NR; ++j)
+                ab[i][j] = ab[i][j] + a[i] * b[j];
+
+    for (std::size_t i = 0; i < mr; ++i)
+        for (std::size_t j = 0; j < nr; ++j)
+            c[i * rsc + j * csc] = c[i * rsc + j * csc] + ab[i][j];
+}
+
+/// Scales the m x n matrix C by beta, clearing it (rather than multiplying NaNs) if beta is zero.
+template <typename T>
+void gemm_scale(std::size_t m, std::size_t n, T beta, T* c, std::size_t rsc, std::size_t csc)
+{
+    if (beta == T{1})
+        return;
+
+    if (beta == T{})
+    {
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+                c[i * rsc + j * csc] = T{};
+        return;
+    }
+
+    for (std::size_t i = 0; i < m; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            c[i * rsc + j * csc] = beta * c[i * rsc + j * csc];
+}
+
+/**
+ * General matrix-matrix product C = alpha * A * B + beta * C.
+ *
+ * All operands are given as a pointer to their first element plus a row and a column stride,
+ * so that row-major, column-major and transposed storage can be passed in alike.
+ *
+ * @param m number of rows of A and C
+ * @param n number of columns of B and C
+ * @param k number of columns of A and rows of B
+ */
+template <typename T>
+void gemm(std::size_t m, std::size_t n, std::size_t k,
+          T alpha,
+          T const* a, std::size_t rsa, std::size_t csa,
+          T const* b, std::size_t rsb, std::size_t csb,
+          T beta,
+          T* c, std::size_t rsc, std::size_t csc)
+{
+    using blocking = gemm_blocking<T>;
+    constexpr auto MR = blocking::MR;
+    constexpr auto NR = blocking::NR;
+    constexpr auto KC = blocking::KC;
+    constexpr auto MC = blocking::MC;
+    constexpr auto NC = blocking::NC;
+
+    gemm_scale(m, n, beta, c, rsc, csc);
+
+    if (m == 0 || n == 0 || k == 0 || alpha == T{})
+        return;
+
+    // Packing buffers are kept per thread so that repeated products do not reallocate.
+    thread_local std::vector<T> packedA;
+    thread_local std::vector<T> packedB;
+    packedA.resize(MC * KC);
+    packedB.resize(KC * ((std::min(NC, n) + NR - 1) / NR) * NR);
+
+    for (std::size_t jc = 0; jc < n; jc += NC)
+    {
+        std::size_t const nc = std::min(NC, n - jc);
+        for (std::size_t pc = 0; pc < k; pc += KC)
+        {
+            std::size_t const kc = std::min(KC, k - pc);
+            gemm_pack_b<T, NR>(kc, nc, b + pc * rsb + jc * csb, rsb, csb, packedB.data());
+
+            for (std::size_t ic = 0; ic < m; ic += MC)
+            {
+                std::size_t const mc = std::min(MC, m - ic);
+                gemm_pack_a<T, MR>(mc, kc, alpha, a + ic * rsa + pc * csa, rsa, csa, packedA.data());
+
+                for (std::size_t jr = 0; jr < nc; jr += NR)
+                    for (std::size_t ir = 0; ir < mc; ir += MR)
+                        gemm_micro_kernel<T, MR, NR>(
+                            kc,
+                            packedA.data() + ir * kc,
+                            packedB.data() + jr * kc,
+                            std::min(MR, mc - ir),
+                            std::min(NR, nc - jr),
+                            c + (ic + ir) * rsc + (jc + jr) * csc, rsc, csc);
+            }
+        }
+    }
+}
+
+/// General matrix-matrix product C = alpha * A * B + beta * C for the given execution policy.
+///
+/// In parallel, the rows of C are split into bands of whole MC blocks, one per thread.
+template <typename ExecutionPolicy, typename T>
+void gemm(ExecutionPolicy,
+          std::size_t m, std::size_t n, std::size_t k,
+          T alpha,
+          T const* a, std::size_t rsa, std::size_t csa,
+          T const* b, std::size_t rsb, std::size_t csb,
+          T beta,
+          T* c, std::size_t rsc, std::size_t csc)
+{
+    if constexpr (std::is_same_v<ExecutionPolicy, execution::parallel_policy>)
+    {
+        constexpr auto MC = gemm_blocking<T>::MC;
+        auto const blocks = (m + MC - 1) / MC;
+        auto const grain = std::max<std::size_t>(1, parallel_grain_size * MC / std::max<std::size_t>(1, n * k));
+        thread_pool::global().parallel_for(blocks, grain, [&](std::size_t first, std::size_t last) {
+            auto const i0 = first * MC;
+            auto const i1 = std::min(m, last * MC);
+            gemm(i1 - i0, n, k, alpha, a + i0 * rsa, rsa, csa, b, rsb, csb, beta, c + i0 * rsc, rsc, csc);
+        });
+    }
+    else
+        gemm(m, n, k, alpha, a, rsa, csa, b, rsb, csb, beta, c, rsc, csc);
+}
+
+// Tests whether the matrix product of the given engines can be computed by the packed GEMM kernel,
+// i.e. all three engines expose (strided) storage of the same arithmetic element type. This includes
+// transpose views, whose span simply exchanges the strides of the viewed engine.
+template <typename ET1, typename ET2, typename ETR>
+constexpr inline bool is_gemm_compatible_v = has_writable_span<ETR>::value && has_flat_storage_v<ETR, ET1, ET2>;
+
+/// Minimal m * n * k for which packing pays off, smaller products are left to the plain loop.
+constexpr inline std::size_t gemm_min_size = 16 * 16 * 16;
+
+} // end namespace
@@ -0,0 +1,94 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+#include "execution.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace LINEAR_ALGEBRA_NAMESPACE::detail {
+
+/**
+ * General matrix-vector product y = alpha * A * x + beta * y, with contiguous x and y.
+ *
+ * A is given as a pointer to its first element plus a row and a column stride, as for gemm().
+ * The kernel picks the loop order from the strides, so that A is always read sequentially:
+ *
+ * - row-major A (csa == 1): y(i) is the dot product of row i and x (see simd::dot),
+ * - column-major A (rsa == 1): y is accumulated column by column, y += (alpha * x(j)) * A(:, j).
+ *
+ * The transposed product y = A^T x is thus simply gemv() with m and n, and rsa and csa exchanged.
+ *
+ * @param m number of rows of A and elements of y
+ * @param n number of columns of A and elements of x
+ */
+template <typename ExecutionPolicy, typename T>
+void gemv(ExecutionPolicy,
+          std::size_t m, std::size_t n,
+          T alpha,
+          T const* a, std::size_t rsa, std::size_t csa,
+          T const* x,
+          T beta,
+          T* y)
+{
+    // rows of y per chunk in parallel, so that each chunk touches about parallel_grain_size elements of A
+    auto const grain = std::max<std::size_t>(1, parallel_grain_size / std::max<std::size_t>(1, n));
+    auto const rows = [&](auto const& body) {
+        if constexpr (std::is_same_v<ExecutionPolicy, execution::parallel_policy>)
+            thread_pool::global().parallel_for(m, grain, body);
+        else
+            body(std::size_t{0}, m);
+    };
+
+    if (csa == 1 || n <= 1)
+    {
+        rows([&](std::size_t i0, std::size_t i1) {
+            for (auto i = i0; i < i1; ++i)
+            {
+                auto const ax = alpha * simd::dot(execution::seq, n, a + i * rsa, x);
+                y[i] = beta == T{} ? ax : ax + beta * y[i];
+            }
+        });
+    }
+    else if (rsa == 1)
+    {
+        rows([&](std::size_t i0, std::size_t i1) {
+            if (beta == T{})
+                std::fill(y + i0, y + i1, T{});
+            else if (beta != T{1})
+                simd::scale(execution::seq, i1 - i0, y + i0, beta, y + i0);
+
+            for (std::size_t j = 0; j < n; ++j)
+                simd::axpy(i1 - i0, alpha * x[j], a + j * csa + i0, y + i0);
+        });
+    }
+    else
+    {
+        rows([&](std::size_t i0, std::size_t i1) {
+            for (auto i = i0; i < i1; ++i)
+            {
+                auto acc = T{};
+                for (std::size_t j = 0; j < n; ++j)
+                    acc = acc + a[i * rsa + j * csa] * x[j];
+                y[i] = beta == T{} ? alpha * acc : alpha * acc + beta * y[i];
+            }
+        });
+    }
+}
+
+} // end namespace
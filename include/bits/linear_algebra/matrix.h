@@ -15,16 +15,22 @@
 #pragma once
 
 #include "base.h"
+#include "assignment_traits.h"
 #include "concepts.h"
+#include "operation_traits_selector.h"
 #include "column_engine.h"
 #include "row_engine.h"
+#include "simd.h"
 #include "submatrix_engine.h"
 #include "transpose_engine.h"
+#include "transpose_kernel.h"
 #include "vector.h"
 
+#include <cassert>
 #include <type_traits>
 #include <initializer_list>
 #include <tuple>
+#include <utility>
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
 
@@ -66,7 +72,7 @@ class matrix {
         std::conditional_t<
             is_submatrix_engine_v<ET>,
             matrix<submatrix_engine<typename ET::element_type, as_writable_matrix_engine_tag>, OT>,
-            matrix<submatrix_engine<ET, readable_matrix_engine_tag>, OT>
+            matrix<submatrix_engine<ET, as_writable_matrix_engine_tag>, OT>
         >;
     using const_submatrix_type =
         std::conditional_t<
@@ -97,6 +103,17 @@ class matrix {
             engine_.reserve(src.row_capacity(), src.column_capacity());
             engine_.resize(src.rows(), src.columns());
         }
+
+        if constexpr (detail::is_flat_compatible_v<ET, ET2>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                // e.g. materializing a transpose view in cache-sized tiles, see transpose_kernel.h
+                detail::copy<value_type>(src.span(), span());
+                return;
+            }
+        }
+
         for (auto [i, j] : times(rows()) * times(columns()))
             (*this)(i, j) = src(i, j);
     }
@@ -116,13 +133,25 @@ class matrix {
         resize(rows, cols);
     }
 
-    constexpr explicit matrix(ET&& _engine) : engine_{std::forward<ET>(_engine)} {} // EXT
+    constexpr explicit matrix(ET&& _engine) : engine_(std::forward<ET>(_engine)) {} // EXT
+
+    // EXT: leaves the elements indeterminate (see uninitialized_t), e.g. for results that are overwritten anyway.
+    constexpr explicit matrix(uninitialized_t _u) LA_CONCEPT(!is_resizable) : engine_(_u) {}
+    constexpr matrix(uninitialized_t _u, size_type rows, size_type cols) LA_CONCEPT(is_resizable)
+        : engine_(_u, rows, cols) {}
+    constexpr matrix(uninitialized_t _u, size_type rows, size_type cols, size_type rowcap, size_type colcap)
+        LA_CONCEPT(is_resizable)
+        : engine_(_u, rows, cols, rowcap, colcap) {}
+
+    // EXT: pads the leading dimension to whole cache lines (see padded_t).
+    constexpr matrix(padded_t _p, size_type rows, size_type cols) LA_CONCEPT(is_resizable) : engine_(_p, rows, cols) {}
 
     // EXT
     template<
         typename Initializer,
         typename std::enable_if_t<
-            std::is_invocable_r_v<value_type, Initializer, size_type, size_type>,
+            std::is_invocable_r_v<value_type, Initializer, size_type, size_type> &&
+            !is_matrix_expression_v<Initializer>,
             int> = 0
     >
     constexpr explicit matrix(Initializer const& _init) noexcept
@@ -136,7 +165,8 @@ class matrix {
     template<
         typename Initializer,
         typename std::enable_if_t<
-            std::is_invocable_r_v<value_type, Initializer, size_type, size_type>,
+            std::is_invocable_r_v<value_type, Initializer, size_type, size_type> &&
+            !is_matrix_expression_v<Initializer>,
             int> = 0
     >
     constexpr matrix(size_type rows, size_type cols, Initializer const& _init) noexcept
@@ -148,21 +178,98 @@ class matrix {
             (*this)(i, j) = _init(i, j);
     }
 
+    // EXT: evaluates a lazy matrix expression (see expression.h)
+    template <typename E, typename std::enable_if_t<is_matrix_expression_v<E>, int> = 0>
+    constexpr matrix(E const& expr) { *this = expr; }
+
     constexpr matrix& operator=(matrix&&) noexcept(std::is_nothrow_move_assignable_v<matrix>) = default;
     constexpr matrix& operator=(matrix const&) = default;
 
     template <class ET2, class OT2>
     constexpr matrix& operator=(matrix<ET2, OT2> const& rhs)
     {
-        if constexpr (is_fixed_size_engine_v<engine_type>)
-            static_assert(rows() == rhs.rows() && columns() == rhs.columns(), "Matrix dimensions must match.");
+        if constexpr (detail::is_flat_compatible_v<ET, ET2>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                // rhs may view this very engine, e.g. in m = m.t(), which detail::copy() transposes
+                // in place if square, and which must not be resized away before it is read otherwise.
+                if constexpr (is_resizable_engine_v<engine_type>)
+                    if (rhs.size() != size() && rhs.span().data() == span().data())
+                    {
+                        engine_ = std::move(matrix(rhs).engine_);
+                        return *this;
+                    }
+
+                if constexpr (is_resizable_engine_v<engine_type>)
+                    resize(rhs.size());
+
+                assert(rows() == rhs.rows() && columns() == rhs.columns());
+                detail::copy<value_type>(rhs.span(), span());
+                return *this;
+            }
+        }
 
         if constexpr (is_resizable_engine_v<engine_type>)
             resize(rhs.size());
 
+        assert(rows() == rhs.rows() && columns() == rhs.columns());
+
         using detail::times;
         for (auto [i, j] : times(rows()) * times(columns()))
             (*this)(i, j) = rhs(i, j);
+
+        return *this;
+    }
+
+    // EXT: evaluates a lazy matrix expression (see expression.h) in a single pass over all operands.
+    template <typename E, typename std::enable_if_t<is_matrix_expression_v<E>, int> = 0>
+    constexpr matrix& operator=(E const& expr)
+    {
+        if constexpr (E::is_fusable)
+        {
+            if constexpr (is_resizable_engine_v<engine_type>)
+                resize(expr.rows(), expr.columns());
+
+            assert(rows() == expr.rows() && columns() == expr.columns());
+
+            using detail::times;
+            for (auto [i, j] : times(rows()) * times(columns()))
+                (*this)(i, j) = expr(i, j);
+        }
+        else
+            *this = expr.eval();
+
+        return *this;
+    }
+
+    //- EXT: In-place arithmetic, via the arithmetic assignment traits of the operation traits
+    //  (see assignment_traits.h). These also update writable views, e.g. m.row(i) *= 2.
+    //
+    template <class ET2, class OT2>
+    constexpr matrix& operator+=(matrix<ET2, OT2> const& rhs)
+    {
+        using op_traits = matrix_operation_traits_selector_t<OT, OT2>;
+        return matrix_addition_assignment_traits_t<op_traits, matrix, matrix<ET2, OT2>>::add_assign(*this, rhs);
+    }
+
+    template <class ET2, class OT2>
+    constexpr matrix& operator-=(matrix<ET2, OT2> const& rhs)
+    {
+        using op_traits = matrix_operation_traits_selector_t<OT, OT2>;
+        return matrix_subtraction_assignment_traits_t<op_traits, matrix, matrix<ET2, OT2>>::subtract_assign(*this, rhs);
+    }
+
+    template <class S2, std::enable_if_t<is_matrix_element_v<S2>, int> = 0>
+    constexpr matrix& operator*=(S2 const& s)
+    {
+        return matrix_multiplication_assignment_traits_t<OT, matrix, S2>::multiply_assign(*this, s);
+    }
+
+    template <class S2, std::enable_if_t<is_matrix_element_v<S2>, int> = 0>
+    constexpr matrix& operator/=(S2 const& s)
+    {
+        return matrix_division_assignment_traits_t<OT, matrix, S2>::divide_assign(*this, s);
     }
 
     //- Capacity
@@ -196,7 +303,7 @@ class matrix {
         // TODO: if curreng engine is a submatrix already, optimize! (required for det(A))
         // submatrix<submatrix<fixed_matrix<T, R, C>>> can become submatrix<fixed_matrix<T, R, C>>
         // but it requires submatrix_engine to be able to eliminate more than one range per direction.
-        return submatrix_type(typename submatrix_type::engine_type(const_cast<ET&>(engine_), ri, rn, ci, cn));
+        return submatrix_type(typename submatrix_type::engine_type(&engine_, ri, rn, ci, cn));
     }
     constexpr const_submatrix_type submatrix(size_type ri, size_type rn,
                                              size_type ci, size_type cn) const noexcept {
@@ -239,6 +346,10 @@ class matrix {
     constexpr engine_type& engine() noexcept { return engine_; }
     constexpr engine_type const& engine() const noexcept { return engine_; }
 
+    // EXT: direct (strided) access to the storage of engines that have a span_type, see span.h.
+    constexpr auto span() noexcept { return engine_.span(); }
+    constexpr auto span() const noexcept { return engine_.span(); }
+
     //- Modifiers
     //
     constexpr void swap(matrix& rhs) noexcept { engine_.swap(rhs.engine_); }
@@ -15,6 +15,14 @@
 #pragma once
 
 #include "base.h"
+#include "execution.h"
+#include "gemm_kernel.h"
+#include "gemv_kernel.h"
+#include "simd.h"
+#include "transpose_engine.h"
+#include "unrolled_kernel.h"
+
+#include <cassert>
 #include <iostream>
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
@@ -30,6 +38,8 @@ template <class OT, class T1, class T2>
 using matrix_multiplication_element_t = typename OT::template element_multiplication_traits<T1, T2>::element_type;
 
 // 6.8.4 | engine promotion traits | matrix_multiplication_engine_traits<OT, ET1, ET2>
+//
+// EXT: matrix results are stored in the layout (see row_major) of the left matrix operand.
 template <class OT, class ET1, class ET2>
 struct matrix_multiplication_engine_traits
 /*{
@@ -58,60 +68,187 @@ struct matrix_multiplication_engine_traits<OT, fs_vector_engine<T1, N1>, scalar_
     using engine_type = fs_vector_engine<matrix_multiplication_element_t<OT, T1, T2>, N1>;
 };
 
-template <class OT, class T1, class T2, std::size_t R2, std::size_t C2>
-struct matrix_multiplication_engine_traits<OT, scalar_engine<T1>, fs_matrix_engine<T2, R2, C2>>
+template <class OT, class T1, class T2, std::size_t R2, std::size_t C2, class L2>
+struct matrix_multiplication_engine_traits<OT, scalar_engine<T1>, fs_matrix_engine<T2, R2, C2, L2>>
 {
     using element_type = matrix_multiplication_element_t<OT, T1, T2>;
-    using engine_type = fs_matrix_engine<matrix_multiplication_element_t<OT, T1, T2>, R2, C2>;
+    using engine_type = fs_matrix_engine<matrix_multiplication_element_t<OT, T1, T2>, R2, C2, L2>;
 };
 
-template <class OT, class T1, std::size_t R1, std::size_t C1, class T2>
-struct matrix_multiplication_engine_traits<OT, fs_matrix_engine<T1, R1, C1>, scalar_engine<T2>>
+template <class OT, class T1, std::size_t R1, std::size_t C1, class T2, class L1>
+struct matrix_multiplication_engine_traits<OT, fs_matrix_engine<T1, R1, C1, L1>, scalar_engine<T2>>
 {
     using element_type = matrix_multiplication_element_t<OT, T1, T2>;
-    using engine_type = fs_matrix_engine<matrix_multiplication_element_t<OT, T1, T2>, R1, C1>;
+    using engine_type = fs_matrix_engine<matrix_multiplication_element_t<OT, T1, T2>, R1, C1, L1>;
 };
 
-template <class OT, class T1, std::size_t R1, std::size_t C1, class T2, std::size_t N2>
-struct matrix_multiplication_engine_traits<OT, fs_matrix_engine<T1, R1, C1>, fs_vector_engine<T2, N2>>
+template <class OT, class T1, class T2, class AT2>
+struct matrix_multiplication_engine_traits<OT, scalar_engine<T1>, dr_vector_engine<T2, AT2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT2>::template rebind_alloc<element_type>;
+    using engine_type = dr_vector_engine<element_type, allocator_type>;
+};
+
+template <class OT, class T1, class AT1, class T2>
+struct matrix_multiplication_engine_traits<OT, dr_vector_engine<T1, AT1>, scalar_engine<T2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT1>::template rebind_alloc<element_type>;
+    using engine_type = dr_vector_engine<element_type, allocator_type>;
+};
+
+template <class OT, class T1, class T2, class AT2, class L2>
+struct matrix_multiplication_engine_traits<OT, scalar_engine<T1>, dr_matrix_engine<T2, AT2, L2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT2>::template rebind_alloc<element_type>;
+    using engine_type = dr_matrix_engine<element_type, allocator_type, L2>;
+};
+
+template <class OT, class T1, class AT1, class T2, class L1>
+struct matrix_multiplication_engine_traits<OT, dr_matrix_engine<T1, AT1, L1>, scalar_engine<T2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT1>::template rebind_alloc<element_type>;
+    using engine_type = dr_matrix_engine<element_type, allocator_type, L1>;
+};
+
+template <class OT, class T1, std::size_t R1, std::size_t C1, class T2, std::size_t N2, class L1>
+struct matrix_multiplication_engine_traits<OT, fs_matrix_engine<T1, R1, C1, L1>, fs_vector_engine<T2, N2>>
 {
     static_assert(C1 == N2, "Matrix-vector multiplication: matrix column count must equal vector element count.");
     using element_type = matrix_multiplication_element_t<OT, T1, T2>;
     using engine_type = fs_vector_engine<matrix_multiplication_element_t<OT, T1, T2>, R1>;
 };
 
-template <class OT, class T1, std::size_t R1, std::size_t C1, class T2, std::size_t R2, std::size_t C2>
-struct matrix_multiplication_engine_traits<OT, fs_matrix_engine<T1, R1, C1>, fs_matrix_engine<T2, R2, C2>>
+template <class OT, class T1, std::size_t R1, std::size_t C1, class T2, std::size_t R2, std::size_t C2, class L1, class L2>
+struct matrix_multiplication_engine_traits<OT, fs_matrix_engine<T1, R1, C1, L1>, fs_matrix_engine<T2, R2, C2, L2>>
 {
     static_assert(C1 == R2, "Matrix-matrix multiplication: left matrix column count must equal right matrix row count.");
     using element_type = matrix_multiplication_element_t<OT, T1, T2>;
-    using engine_type = fs_matrix_engine<matrix_multiplication_element_t<OT, T1, T2>, R1, C2>;
+    using engine_type = fs_matrix_engine<matrix_multiplication_element_t<OT, T1, T2>, R1, C2, L1>;
+};
+
+// (dr * dr)
+template <typename OT, typename T1, typename AT1, typename T2, typename AT2, typename L1, typename L2>
+struct matrix_multiplication_engine_traits<OT, dr_matrix_engine<T1, AT1, L1>, dr_matrix_engine<T2, AT2, L2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT1>::template rebind_alloc<element_type>;
+    using engine_type = dr_matrix_engine<element_type, allocator_type, L1>;
+};
+
+// (fs * dr)
+template <typename OT, typename T1, std::size_t R1, std::size_t C1, typename T2, typename AT2, typename L1, typename L2>
+struct matrix_multiplication_engine_traits<OT, fs_matrix_engine<T1, R1, C1, L1>, dr_matrix_engine<T2, AT2, L2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT2>::template rebind_alloc<element_type>;
+    using engine_type = dr_matrix_engine<element_type, allocator_type, L1>;
+};
+
+// (dr * fs)
+template <typename OT, typename T1, typename AT1, typename T2, std::size_t R2, std::size_t C2, typename L1, typename L2>
+struct matrix_multiplication_engine_traits<OT, dr_matrix_engine<T1, AT1, L1>, fs_matrix_engine<T2, R2, C2, L2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT1>::template rebind_alloc<element_type>;
+    using engine_type = dr_matrix_engine<element_type, allocator_type, L1>;
+};
+
+// (fs * fs), vector * matrix
+template <typename OT, typename T1, std::size_t N1, typename T2, std::size_t R2, std::size_t C2, typename L2>
+struct matrix_multiplication_engine_traits<OT, fs_vector_engine<T1, N1>, fs_matrix_engine<T2, R2, C2, L2>>
+{
+    static_assert(N1 == R2, "Vector-matrix multiplication: vector element count must equal matrix row count.");
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using engine_type = fs_vector_engine<element_type, C2>;
+};
+
+// (dr * dr), matrix * vector
+template <typename OT, typename T1, typename AT1, typename T2, typename AT2, typename L1>
+struct matrix_multiplication_engine_traits<OT, dr_matrix_engine<T1, AT1, L1>, dr_vector_engine<T2, AT2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT2>::template rebind_alloc<element_type>;
+    using engine_type = dr_vector_engine<element_type, allocator_type>;
+};
+
+// (dr * fs), matrix * vector
+template <typename OT, typename T1, typename AT1, typename T2, std::size_t N2, typename L1>
+struct matrix_multiplication_engine_traits<OT, dr_matrix_engine<T1, AT1, L1>, fs_vector_engine<T2, N2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT1>::template rebind_alloc<element_type>;
+    using engine_type = dr_vector_engine<element_type, allocator_type>;
+};
+
+// (fs * dr), matrix * vector
+template <typename OT, typename T1, std::size_t R1, std::size_t C1, typename T2, typename AT2, typename L1>
+struct matrix_multiplication_engine_traits<OT, fs_matrix_engine<T1, R1, C1, L1>, dr_vector_engine<T2, AT2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using engine_type = fs_vector_engine<element_type, R1>;
+};
+
+// (dr * dr), vector * matrix
+template <typename OT, typename T1, typename AT1, typename T2, typename AT2, typename L2>
+struct matrix_multiplication_engine_traits<OT, dr_vector_engine<T1, AT1>, dr_matrix_engine<T2, AT2, L2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT1>::template rebind_alloc<element_type>;
+    using engine_type = dr_vector_engine<element_type, allocator_type>;
 };
 
-// (fs * transpose)
-template <typename OT,
-          typename T1, std::size_t R1, std::size_t C1,
-          typename T2, typename MCT2, std::size_t R2, std::size_t C2>
-struct matrix_multiplication_engine_traits<OT,
-                                           fs_matrix_engine<T1, R1, C1>,
-                                           transpose_engine<fs_matrix_engine<T2, R2, C2>, MCT2>>
+// (fs * dr), vector * matrix
+template <typename OT, typename T1, std::size_t N1, typename T2, typename AT2, typename L2>
+struct matrix_multiplication_engine_traits<OT, fs_vector_engine<T1, N1>, dr_matrix_engine<T2, AT2, L2>>
 {
-    static_assert(C1 == C2, "Matrix-matrix multiplication: left matrix column count must equal right matrix row count.");
     using element_type = matrix_multiplication_element_t<OT, T1, T2>;
-    using engine_type = fs_matrix_engine<element_type, R1, R2>;
+    using allocator_type = typename std::allocator_traits<AT2>::template rebind_alloc<element_type>;
+    using engine_type = dr_vector_engine<element_type, allocator_type>;
 };
 
-// (transpose(fs) * transpose(fs))
-template <typename OT,
-          typename T1, typename MCT1, std::size_t R1, std::size_t C1,
-          typename T2, typename MCT2, std::size_t R2, std::size_t C2>
-struct matrix_multiplication_engine_traits<OT,
-                                           transpose_engine<fs_matrix_engine<T1, R1, C1>, MCT1>,
-                                           transpose_engine<fs_matrix_engine<T2, R2, C2>, MCT2>>
+// (dr * fs), vector * matrix
+template <typename OT, typename T1, typename AT1, typename T2, std::size_t R2, std::size_t C2, typename L2>
+struct matrix_multiplication_engine_traits<OT, dr_vector_engine<T1, AT1>, fs_matrix_engine<T2, R2, C2, L2>>
 {
-    static_assert(R1 == C2, "Matrix-matrix multiplication: left matrix column count must equal right matrix row count.");
     using element_type = matrix_multiplication_element_t<OT, T1, T2>;
-    using engine_type = fs_matrix_engine<element_type, C1, R2>;
+    using engine_type = fs_vector_engine<element_type, C2>;
+};
+
+// (ET * transpose), (transpose * ET), (transpose * transpose)
+//
+// A transpose view multiplies like the engine type of the transposed matrix, see transposed_engine_t.
+template <typename OT, typename ET1, typename ET2, typename MCT2>
+struct matrix_multiplication_engine_traits<OT, ET1, transpose_engine<ET2, MCT2>>
+    : public matrix_multiplication_engine_traits<OT, ET1, detail::transposed_engine_t<ET2>> {};
+
+template <typename OT, typename ET1, typename MCT1, typename ET2>
+struct matrix_multiplication_engine_traits<OT, transpose_engine<ET1, MCT1>, ET2>
+    : public matrix_multiplication_engine_traits<OT, detail::transposed_engine_t<ET1>, ET2> {};
+
+template <typename OT, typename ET1, typename MCT1, typename ET2, typename MCT2>
+struct matrix_multiplication_engine_traits<OT, transpose_engine<ET1, MCT1>, transpose_engine<ET2, MCT2>>
+    : public matrix_multiplication_engine_traits<OT, detail::transposed_engine_t<ET1>, detail::transposed_engine_t<ET2>> {};
+
+// (csr * dr)
+template <typename OT, typename T1, typename AT1, typename T2, typename AT2>
+struct matrix_multiplication_engine_traits<OT, csr_matrix_engine<T1, AT1>, dr_vector_engine<T2, AT2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT2>::template rebind_alloc<element_type>;
+    using engine_type = dr_vector_engine<element_type, allocator_type>;
+};
+
+// (csr * fs)
+template <typename OT, typename T1, typename AT1, typename T2, std::size_t N2>
+struct matrix_multiplication_engine_traits<OT, csr_matrix_engine<T1, AT1>, fs_vector_engine<T2, N2>>
+{
+    using element_type = matrix_multiplication_element_t<OT, T1, T2>;
+    using allocator_type = typename std::allocator_traits<AT1>::template rebind_alloc<element_type>;
+    using engine_type = dr_vector_engine<element_type, allocator_type>;
 };
 
 template <class OT, class ET1, class ET2>
@@ -135,14 +272,29 @@ struct matrix_multiplication_traits<OT, vector<ET1, OT1>, T2>
     using result_type = vector<engine_type, op_traits>;
     constexpr static result_type multiply(vector<ET1, OT1> const& v1, T2 const& s2)
     {
-        result_type r;
+        return multiply(execution_policy_t<OT>{}, v1, s2);
+    }
 
-        if constexpr (is_resizable_engine_v<engine_type>)
-            r.resize(v1.size());
+    template <class ExecutionPolicy>
+    constexpr static result_type multiply(ExecutionPolicy policy, vector<ET1, OT1> const& v1, T2 const& s2)
+    {
+        auto r = detail::make_uninitialized<result_type>(v1.size());
+
+        if constexpr (detail::is_flat_compatible_v<engine_type, ET1> && std::is_same_v<T2, typename engine_type::value_type>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const a = v1.span();
+                auto const c = r.span();
+                auto const kernel = [&](auto p, std::size_t n, auto* x, auto const* y) { detail::simd::scale(p, n, y, s2, x); };
+                if (detail::for_each_run(policy, kernel, c, a))
+                    return r;
+            }
+        }
 
         using detail::times;
         using detail::for_each;
-        for_each(times(v1.size()), [&](auto i) constexpr { r(i) = v1(i) * s2; });
+        for_each(policy, times(v1.size()), [&](auto i) constexpr { r(i) = v1(i) * s2; });
 
         return r;
     }
@@ -158,14 +310,29 @@ struct matrix_multiplication_traits<OT, T1, vector<ET2, OT2>>
     using result_type = vector<engine_type, op_traits>;
     constexpr static result_type multiply(T1 const& s1, vector<ET2, OT2> const& v2)
     {
-        result_type r;
+        return multiply(execution_policy_t<OT>{}, s1, v2);
+    }
 
-        if constexpr (is_resizable_engine_v<engine_type>)
-            r.resize(v2.size());
+    template <class ExecutionPolicy>
+    constexpr static result_type multiply(ExecutionPolicy policy, T1 const& s1, vector<ET2, OT2> const& v2)
+    {
+        auto r = detail::make_uninitialized<result_type>(v2.size());
+
+        if constexpr (detail::is_flat_compatible_v<engine_type, ET2> && std::is_same_v<T1, typename engine_type::value_type>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const a = v2.span();
+                auto const c = r.span();
+                auto const kernel = [&](auto p, std::size_t n, auto* x, auto const* y) { detail::simd::scale(p, n, y, s1, x); };
+                if (detail::for_each_run(policy, kernel, c, a))
+                    return r;
+            }
+        }
 
         using detail::times;
         using detail::for_each;
-        for_each(times(v2.size()), [&](auto i) constexpr { r(i) = s1 * v2(i); });
+        for_each(policy, times(v2.size()), [&](auto i) constexpr { r(i) = s1 * v2(i); });
 
         return r;
     }
@@ -181,14 +348,36 @@ struct matrix_multiplication_traits<OT, matrix<ET1, OT1>, T2>
     using result_type = matrix<engine_type, op_traits>;
     constexpr static result_type multiply(matrix<ET1, OT1> const& m1, T2 const& s2)
     {
-        result_type r;
+        return multiply(execution_policy_t<OT>{}, m1, s2);
+    }
 
-        if constexpr (is_resizable_engine_v<engine_type>)
-            r.resize(m1.size());
+    template <class ExecutionPolicy>
+    constexpr static result_type multiply(ExecutionPolicy policy, matrix<ET1, OT1> const& m1, T2 const& s2)
+    {
+        auto r = detail::make_uninitialized<result_type>(m1.rows(), m1.columns());
+
+        if constexpr (detail::is_unrollable_v<engine_type, ET1>)
+        {
+            detail::unrolled_assign(r, [&](auto i, auto j) { return m1(i, j) * s2; });
+            return r;
+        }
+        else if constexpr (detail::is_flat_compatible_v<engine_type, ET1> && std::is_same_v<T2, typename engine_type::value_type>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const a = m1.span();
+                auto const c = r.span();
+                auto const kernel = [&](auto p, std::size_t n, auto* x, auto const* y) { detail::simd::scale(p, n, y, s2, x); };
+                if (detail::for_each_run(policy, kernel, c, a))
+                    return r;
+            }
+        }
 
         using detail::times;
-        for (auto [i, j] : times(r.rows()) * times(r.columns()))
+        detail::for_each(policy, times(r.rows()) * times(r.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
             r(i, j) = m1(i, j) * s2;
+        });
 
         return r;
     }
@@ -204,15 +393,36 @@ struct matrix_multiplication_traits<OT, T1, matrix<ET2, OT2>>
     using result_type = matrix<engine_type, op_traits>;
     constexpr static result_type multiply(T1 const& s1, matrix<ET2, OT2> const& m2)
     {
-        return matrix_multiplication_traits<OT, matrix<ET2, OT2>, T1>::multiply(m2, s1);
-        result_type r;
+        return multiply(execution_policy_t<OT>{}, s1, m2);
+    }
 
-        if constexpr (is_resizable_engine_v<engine_type>)
-            r.resize(m2.size());
+    template <class ExecutionPolicy>
+    constexpr static result_type multiply(ExecutionPolicy policy, T1 const& s1, matrix<ET2, OT2> const& m2)
+    {
+        auto r = detail::make_uninitialized<result_type>(m2.rows(), m2.columns());
+
+        if constexpr (detail::is_unrollable_v<engine_type, ET2>)
+        {
+            detail::unrolled_assign(r, [&](auto i, auto j) { return s1 * m2(i, j); });
+            return r;
+        }
+        else if constexpr (detail::is_flat_compatible_v<engine_type, ET2> && std::is_same_v<T1, typename engine_type::value_type>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const a = m2.span();
+                auto const c = r.span();
+                auto const kernel = [&](auto p, std::size_t n, auto* x, auto const* y) { detail::simd::scale(p, n, y, s1, x); };
+                if (detail::for_each_run(policy, kernel, c, a))
+                    return r;
+            }
+        }
 
         using detail::times;
-        for (auto [i, j] : times(r.rows()) * times(r.columns()))
+        detail::for_each(policy, times(r.rows()) * times(r.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
             r(i, j) = s1 * m2(i, j);
+        });
 
         return r;
     }
@@ -229,9 +439,25 @@ struct matrix_multiplication_traits<OT, vector<ET1, OT1>, vector<ET2, OT2>>
     using result_type = matrix_multiplication_element_t<op_traits, elem_type_1, elem_type_2>;
     constexpr static result_type multiply(vector<ET1, OT1> const& v1, vector<ET2, OT2> const& v2)
     {
+        return multiply(execution_policy_t<OT>{}, v1, v2);
+    }
+
+    template <class ExecutionPolicy>
+    constexpr static result_type multiply(ExecutionPolicy policy, vector<ET1, OT1> const& v1, vector<ET2, OT2> const& v2)
+    {
+        if constexpr (detail::has_flat_storage_v<ET1, ET2> && std::is_same_v<result_type, typename ET1::value_type>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const a = v1.span();
+                auto const b = v2.span();
+                if (detail::is_flat(a, b))
+                    return detail::simd::dot(policy, a.size(), a.data(), b.data());
+            }
+        }
+
         using detail::times;
-        using detail::reduce;
-        return reduce(times(v1.size()), result_type{}, [&](auto acc, auto i) constexpr { return acc + v1(i) * v2(i); });
+        return detail::sum(policy, times(v1.size()), result_type{}, [&](auto i) constexpr { return v1(i) * v2(i); });
     }
 };
 
@@ -243,17 +469,60 @@ struct matrix_multiplication_traits<OT, matrix<ET1, OT1>, vector<ET2, OT2>>
     using op_traits = OT;
     using result_type = vector<engine_type, op_traits>;
     constexpr static result_type multiply(matrix<ET1, OT1> const& m1, vector<ET2, OT2> const& m2)
+    {
+        return multiply(execution_policy_t<OT>{}, m1, m2);
+    }
+
+    template <class ExecutionPolicy>
+    constexpr static result_type multiply(ExecutionPolicy policy, matrix<ET1, OT1> const& m1, vector<ET2, OT2> const& m2)
     {
         using detail::reduce;
         using detail::times;
-
-        result_type r;
-
-        if constexpr (is_resizable_engine_v<engine_type>)
-            r.resize(m1.columns());
-
-        for (auto i : times(m1.rows()))
-            r(i) = reduce(times(m1.columns()), 0, [&](auto acc, auto j) { return acc + m1(i, j) * m2(j); });
+        using value_type = typename result_type::value_type;
+
+        auto r = detail::make_uninitialized<result_type>(m1.rows());
+
+        if constexpr (is_csr_matrix_engine_v<ET1>)
+        {
+            // sparse matrix-vector product, visiting only the stored elements of each row
+            auto const& offsets = m1.engine().row_offsets();
+            auto const& columns = m1.engine().column_indices();
+            auto const& values = m1.engine().values();
+            detail::for_each(policy, times(m1.rows()), [&](auto i) {
+                auto acc = value_type{};
+                for (auto p = offsets[i]; p < offsets[i + 1]; ++p)
+                    acc = acc + values[p] * m2(columns[p]);
+                r(i) = acc;
+            });
+            return r;
+        }
+
+        if constexpr (detail::is_unrollable_v<ET1, ET2>)
+        {
+            detail::unrolled_multiply_vector(r, m1, m2);
+            return r;
+        }
+        else if constexpr (detail::is_flat_compatible_v<engine_type, ET1, ET2>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const a = m1.span();
+                auto const x = m2.span();
+                auto const y = r.span();
+                if (x.is_contiguous() && y.is_contiguous())
+                {
+                    assert(a.columns() == x.size());
+                    detail::gemv(policy, a.rows(), a.columns(), value_type{1},
+                                 a.data(), a.row_stride(), a.column_stride(),
+                                 x.data(), value_type{}, y.data());
+                    return r;
+                }
+            }
+        }
+
+        detail::for_each(policy, times(m1.rows()), [&](auto i) {
+            r(i) = reduce(times(m1.columns()), value_type{}, [&](auto acc, auto j) { return acc + m1(i, j) * m2(j); });
+        });
 
         return r;
     }
@@ -268,22 +537,46 @@ struct matrix_multiplication_traits<OT, vector<ET1, OT1>, matrix<ET2, OT2>>
     using result_type = vector<engine_type, op_traits>;
     constexpr static result_type multiply(vector<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
     {
-        if constexpr (is_fixed_size_engine_v<engine_type>)
-            static_assert(m1.size() == m2.rows(),
-                          "Left-hand-side vector element count must match right-hand-side matrix row count.");
+        return multiply(execution_policy_t<OT>{}, m1, m2);
+    }
 
-        result_type r;
+    template <class ExecutionPolicy>
+    constexpr static result_type multiply(ExecutionPolicy policy, vector<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
+    {
+        assert(m1.size() == m2.rows());
 
-        if constexpr (is_resizable_engine_v<engine_type>)
-            r.resize(m2.columns());
+        auto r = detail::make_uninitialized<result_type>(m2.columns());
 
         using detail::times;
         using detail::reduce;
-
-        for (auto j : times(m2.columns()))
-            r(j) = detail::reduce(detail::times(m2.rows(), 0, [&, j=j](auto acc, auto i) {
-                return acc + m1(i) * m2(i, j);
-            }));
+        using value_type = typename result_type::value_type;
+
+        if constexpr (detail::is_unrollable_v<ET1, ET2>)
+        {
+            detail::unrolled_vector_multiply(r, m1, m2);
+            return r;
+        }
+        else if constexpr (detail::is_flat_compatible_v<engine_type, ET1, ET2>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                // r = m2^T m1, which walks the rows of a row-major m2 as axpy updates of r
+                auto const x = m1.span();
+                auto const a = m2.span();
+                auto const y = r.span();
+                if (x.is_contiguous() && y.is_contiguous())
+                {
+                    detail::gemv(policy, a.columns(), a.rows(), value_type{1},
+                                 a.data(), a.column_stride(), a.row_stride(),
+                                 x.data(), value_type{}, y.data());
+                    return r;
+                }
+            }
+        }
+
+        detail::for_each(policy, times(m2.columns()), [&](auto j) {
+            r(j) = reduce(times(m2.rows()), value_type{}, [&](auto acc, auto i) { return acc + m1(i) * m2(i, j); });
+        });
 
         return r;
     }
@@ -298,19 +591,48 @@ struct matrix_multiplication_traits<OT, matrix<ET1, OT1>, matrix<ET2, OT2>>
     using result_type = matrix<engine_type, op_traits>;
     constexpr static result_type multiply(matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
     {
-        result_type r;
+        return multiply(execution_policy_t<OT>{}, m1, m2);
+    }
 
-        if constexpr (is_resizable_engine_v<engine_type>)
-            r.resize(m1.rows(), m2.columns());
+    template <class ExecutionPolicy>
+    constexpr static result_type multiply(ExecutionPolicy policy, matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
+    {
+        auto r = detail::make_uninitialized<result_type>(m1.rows(), m2.columns());
+
+        // Small fixed-size products are unrolled at compile time, see unrolled_kernel.h.
+        // Transposed operands are passed to the GEMM kernel as strides, which it packs sequentially.
+        if constexpr (detail::is_unrollable_v<engine_type, ET1, ET2>)
+        {
+            detail::unrolled_multiply(r, m1, m2);
+            return r;
+        }
+        else if constexpr (detail::is_gemm_compatible_v<ET1, ET2, engine_type>)
+        {
+            if (!detail::is_constant_evaluated() && r.rows() * r.columns() * m1.columns() >= detail::gemm_min_size)
+            {
+                auto const a = m1.span();
+                auto const b = m2.span();
+                auto const c = r.span();
+                detail::gemm(policy, a.rows(), b.columns(), a.columns(),
+                             typename engine_type::value_type{1},
+                             a.data(), a.row_stride(), a.column_stride(),
+                             b.data(), b.row_stride(), b.column_stride(),
+                             typename engine_type::value_type{},
+                             c.data(), c.row_stride(), c.column_stride());
+                return r;
+            }
+        }
 
         using detail::times;
         using detail::reduce;
         using value_type = typename engine_type::value_type;
 
-        for (auto [i, j] : times(r.rows()) * times(r.columns()))
+        detail::for_each(policy, times(r.rows()) * times(r.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
             r(i, j) = reduce(times(m1.columns()), value_type{}, [&, i = i, j = j](auto acc, auto k) {
                 return acc + m1(i, k) * m2(k, j);
             });
+        });
 
         return r;
     }
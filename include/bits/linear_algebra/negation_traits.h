@@ -15,6 +15,8 @@
 #pragma once
 
 #include "base.h"
+#include "execution.h"
+#include "simd.h"
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
 
@@ -53,14 +55,27 @@ struct matrix_negation_traits<OT, vector<ET1, OT1>>
     using result_type = vector<engine_type, op_traits>;
     constexpr static result_type negate(vector<ET1, OT1> const& v1)
     {
-        auto res = result_type{};
-
-        if constexpr (is_resizable_engine_v<engine_type>)
-            res.resize(v1.size());
+        return negate(execution_policy_t<OT>{}, v1);
+    }
 
-        size_t i = 0;
-        for (auto const& v : v1)
-            res(i++) = -v;
+    template <class ExecutionPolicy>
+    constexpr static result_type negate(ExecutionPolicy policy, vector<ET1, OT1> const& v1)
+    {
+        auto res = detail::make_uninitialized<result_type>(v1.size());
+
+        if constexpr (detail::is_flat_compatible_v<engine_type, ET1>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const r = res.span();
+                auto const a = v1.span();
+                auto const kernel = [](auto p, std::size_t n, auto* x, auto const* y) { detail::simd::negate(p, n, y, x); };
+                if (detail::for_each_run(policy, kernel, r, a))
+                    return res;
+            }
+        }
+
+        detail::for_each(policy, detail::times(v1.size()), [&](auto i) { res(i) = -v1(i); });
         return res;
     }
 };
@@ -73,14 +88,31 @@ struct matrix_negation_traits<OT, matrix<ET1, OT1>>
     using result_type = matrix<engine_type, op_traits>;
     constexpr static result_type negate(matrix<ET1, OT1> const& m1)
     {
-        auto m = result_type{};
-
-        if constexpr (is_resizable_engine_v<engine_type>)
-            m.resize(m1.rows(), m1.columns());
+        return negate(execution_policy_t<OT>{}, m1);
+    }
 
-        for (decltype(m1.rows()) i = 0; i < m1.rows(); ++i)
-            for (decltype(m1.columns()) j = 0; j < m1.columns(); ++j)
-                m(i, j) = -m1(i, j);
+    template <class ExecutionPolicy>
+    constexpr static result_type negate(ExecutionPolicy policy, matrix<ET1, OT1> const& m1)
+    {
+        auto m = detail::make_uninitialized<result_type>(m1.rows(), m1.columns());
+
+        if constexpr (detail::is_flat_compatible_v<engine_type, ET1>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const r = m.span();
+                auto const a = m1.span();
+                auto const kernel = [](auto p, std::size_t n, auto* x, auto const* y) { detail::simd::negate(p, n, y, x); };
+                if (detail::for_each_run(policy, kernel, r, a))
+                    return m;
+            }
+        }
+
+        using detail::times;
+        detail::for_each(policy, times(m1.rows()) * times(m1.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
+            m(i, j) = -m1(i, j);
+        });
 
         return m;
     }
@@ -20,6 +20,7 @@
 #include "addition_traits.h"
 #include "subtraction_traits.h"
 #include "multiplication_traits.h"
+#include "assignment_traits.h"
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
 
@@ -63,6 +64,17 @@ struct matrix_operation_traits
     using subtraction_traits = matrix_subtraction_traits<OTR, OP1, OP2>;
     template <class OTR, class OP1, class OP2>
     using multiplication_traits = matrix_multiplication_traits<OTR, OP1, OP2>;
+
+    //- EXT: default arithmetic assignment traits, for +=, -=, *= (scalar) and /= (scalar).
+    //
+    template <class OTR, class OP1, class OP2>
+    using addition_assignment_traits = matrix_addition_assignment_traits<OTR, OP1, OP2>;
+    template <class OTR, class OP1, class OP2>
+    using subtraction_assignment_traits = matrix_subtraction_assignment_traits<OTR, OP1, OP2>;
+    template <class OTR, class OP1, class S2>
+    using multiplication_assignment_traits = matrix_multiplication_assignment_traits<OTR, OP1, S2>;
+    template <class OTR, class OP1, class S2>
+    using division_assignment_traits = matrix_division_assignment_traits<OTR, OP1, S2>;
 };
 
 } // end namespace
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "base.h"
+#include "span.h"
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
 
@@ -52,6 +53,13 @@ class vector_view_engine<ET, VCT, row_view_tag> {
     using const_reference = typename ET::const_reference;
     using difference_type = typename ET::difference_type;
     using size_type = typename ET::size_type;
+    using span_type = std::conditional_t<
+        has_span_v<ET>,
+        vector_span<std::conditional_t<std::is_same_v<VCT, readable_vector_engine_tag>,
+                                       element_type const,
+                                       std::remove_pointer_t<pointer>>>,
+        void>;
+    using const_span_type = std::conditional_t<has_span_v<ET>, vector_span<element_type const>, void>;
 
     using iterator = _Iterator<ET>; // Implementation-defined
     using const_iterator = _Iterator<std::add_const_t<ET>>; //- Implementation-defined
@@ -84,6 +92,10 @@ class vector_view_engine<ET, VCT, row_view_tag> {
     //
     constexpr reference operator()(size_type j) const { return (*engine_)(row_, j); }
 
+    //- Data access
+    //
+    constexpr span_type span() const noexcept { return engine_->span().row(row_); }
+
     //- Modifiers
     //
     constexpr void swap(vector_view_engine& rhs)
@@ -0,0 +1,468 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+#include "execution.h"
+#include "span.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Instruction set the SIMD kernels are compiled for, selected by the target flags
+// (e.g. -mavx2 or -march=native), and overridable by defining LA_SIMD_ISA up front:
+// 0 = scalar (loops left to the auto-vectorizer), 1 = SSE2, 2 = AVX (AVX2), 3 = AVX-512F.
+#if !defined(LA_SIMD_ISA)
+    #if defined(__AVX512F__)
+        #define LA_SIMD_ISA 3
+    #elif defined(__AVX__)
+        #define LA_SIMD_ISA 2
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define LA_SIMD_ISA 1
+    #else
+        #define LA_SIMD_ISA 0
+    #endif
+#endif
+
+#if LA_SIMD_ISA > 0
+#include <immintrin.h>
+#endif
+
+namespace LINEAR_ALGEBRA_NAMESPACE::detail {
+
+/// Tests whether the current evaluation happens in a constant expression,
+/// where the intrinsics based kernels cannot be used.
+constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#else
+    return __builtin_is_constant_evaluated();
+#endif
+}
+
+namespace simd {
+
+/// Name of the instruction set the kernels were compiled for.
+constexpr inline char const* isa_name = LA_SIMD_ISA == 3 ? "avx512f"
+                                      : LA_SIMD_ISA == 2 ? "avx"
+                                      : LA_SIMD_ISA == 1 ? "sse2"
+                                      : "scalar";
+
+/**
+ * SIMD register of T, with `width` lanes.
+ *
+ * The primary template (width 1) means there is no SIMD support for T, in which case
+ * the kernels fall back to plain loops.
+ */
+template <typename T>
+struct pack {
+    static constexpr std::size_t width = 1;
+};
+
+#if LA_SIMD_ISA == 3
+template <>
+struct pack<float> {
+    using type = __m512;
+    static constexpr std::size_t width = 16;
+    static type load(float const* p) noexcept { return _mm512_loadu_ps(p); }
+    static void store(float* p, type x) noexcept { _mm512_storeu_ps(p, x); }
+    static type broadcast(float s) noexcept { return _mm512_set1_ps(s); }
+    static type add(type a, type b) noexcept { return _mm512_add_ps(a, b); }
+    static type sub(type a, type b) noexcept { return _mm512_sub_ps(a, b); }
+    static type mul(type a, type b) noexcept { return _mm512_mul_ps(a, b); }
+    static type div(type a, type b) noexcept { return _mm512_div_ps(a, b); }
+    static type neg(type a) noexcept
+    {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(int(0x80000000))));
+    }
+};
+
+template <>
+struct pack<double> {
+    using type = __m512d;
+    static constexpr std::size_t width = 8;
+    static type load(double const* p) noexcept { return _mm512_loadu_pd(p); }
+    static void store(double* p, type x) noexcept { _mm512_storeu_pd(p, x); }
+    static type broadcast(double s) noexcept { return _mm512_set1_pd(s); }
+    static type add(type a, type b) noexcept { return _mm512_add_pd(a, b); }
+    static type sub(type a, type b) noexcept { return _mm512_sub_pd(a, b); }
+    static type mul(type a, type b) noexcept { return _mm512_mul_pd(a, b); }
+    static type div(type a, type b) noexcept { return _mm512_div_pd(a, b); }
+    static type neg(type a) noexcept
+    {
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(0x8000000000000000LL)));
+    }
+};
+#elif LA_SIMD_ISA == 2
+template <>
+struct pack<float> {
+    using type = __m256;
+    static constexpr std::size_t width = 8;
+    static type load(float const* p) noexcept { return _mm256_loadu_ps(p); }
+    static void store(float* p, type x) noexcept { _mm256_storeu_ps(p, x); }
+    static type broadcast(float s) noexcept { return _mm256_set1_ps(s); }
+    static type add(type a, type b) noexcept { return _mm256_add_ps(a, b); }
+    static type sub(type a, type b) noexcept { return _mm256_sub_ps(a, b); }
+    static type mul(type a, type b) noexcept { return _mm256_mul_ps(a, b); }
+    static type div(type a, type b) noexcept { return _mm256_div_ps(a, b); }
+    static type neg(type a) noexcept { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+};
+
+template <>
+struct pack<double> {
+    using type = __m256d;
+    static constexpr std::size_t width = 4;
+    static type load(double const* p) noexcept { return _mm256_loadu_pd(p); }
+    static void store(double* p, type x) noexcept { _mm256_storeu_pd(p, x); }
+    static type broadcast(double s) noexcept { return _mm256_set1_pd(s); }
+    static type add(type a, type b) noexcept { return _mm256_add_pd(a, b); }
+    static type sub(type a, type b) noexcept { return _mm256_sub_pd(a, b); }
+    static type mul(type a, type b) noexcept { return _mm256_mul_pd(a, b); }
+    static type div(type a, type b) noexcept { return _mm256_div_pd(a, b); }
+    static type neg(type a) noexcept { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+};
+#elif LA_SIMD_ISA == 1
+template <>
+struct pack<float> {
+    using type = __m128;
+    static constexpr std::size_t width = 4;
+    static type load(float const* p) noexcept { return _mm_loadu_ps(p); }
+    static void store(float* p, type x) noexcept { _mm_storeu_ps(p, x); }
+    static type broadcast(float s) noexcept { return _mm_set1_ps(s); }
+    static type add(type a, type b) noexcept { return _mm_add_ps(a, b); }
+    static type sub(type a, type b) noexcept { return _mm_sub_ps(a, b); }
+    static type mul(type a, type b) noexcept { return _mm_mul_ps(a, b); }
+    static type div(type a, type b) noexcept { return _mm_div_ps(a, b); }
+    static type neg(type a) noexcept { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+};
+
+template <>
+struct pack<double> {
+    using type = __m128d;
+    static constexpr std::size_t width = 2;
+    static type load(double const* p) noexcept { return _mm_loadu_pd(p); }
+    static void store(double* p, type x) noexcept { _mm_storeu_pd(p, x); }
+    static type broadcast(double s) noexcept { return _mm_set1_pd(s); }
+    static type add(type a, type b) noexcept { return _mm_add_pd(a, b); }
+    static type sub(type a, type b) noexcept { return _mm_sub_pd(a, b); }
+    static type mul(type a, type b) noexcept { return _mm_mul_pd(a, b); }
+    static type div(type a, type b) noexcept { return _mm_div_pd(a, b); }
+    static type neg(type a) noexcept { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+};
+#endif
+
+// ---------------------------------------------------------------------------------------------------
+// Element-wise kernels over flat arrays of n elements. The output may alias any of the inputs.
+
+/// Runs kernel(begin, end) over [0, n), split into chunks on the thread pool for execution::par.
+template <typename T, typename ExecutionPolicy, typename Kernel>
+void for_chunks(ExecutionPolicy, std::size_t n, Kernel const& kernel)
+{
+    if constexpr (std::is_same_v<ExecutionPolicy, execution::parallel_policy>)
+    {
+        // chunk boundaries on full packs, so that only the very last chunk has a scalar tail
+        constexpr auto W = pack<T>::width;
+        thread_pool::global().parallel_for(n / W, parallel_grain_size / W, [&](std::size_t _begin, std::size_t _end) {
+            kernel(_begin * W, _end * W == n / W * W ? n : _end * W);
+        });
+    }
+    else
+        kernel(std::size_t{0}, n);
+}
+
+// Element-wise operations, applicable to both, packs P and scalars.
+struct plus_op {
+    template <typename P> static typename P::type apply(typename P::type a, typename P::type b) noexcept { return P::add(a, b); }
+    template <typename T> T operator()(T const& a, T const& b) const { return a + b; }
+};
+
+struct minus_op {
+    template <typename P> static typename P::type apply(typename P::type a, typename P::type b) noexcept { return P::sub(a, b); }
+    template <typename T> T operator()(T const& a, T const& b) const { return a - b; }
+};
+
+// b - a, i.e. minus_op with exchanged operands, for updating the right hand side in place.
+struct reverse_minus_op {
+    template <typename P> static typename P::type apply(typename P::type a, typename P::type b) noexcept { return P::sub(b, a); }
+    template <typename T> T operator()(T const& a, T const& b) const { return b - a; }
+};
+
+struct negate_op {
+    template <typename P> static typename P::type apply(typename P::type a) noexcept { return P::neg(a); }
+    template <typename T> T operator()(T const& a) const { return -a; }
+};
+
+template <typename T, typename Op, typename ExecutionPolicy>
+void transform(ExecutionPolicy policy, std::size_t n, T const* a, T* r, Op op)
+{
+    for_chunks<T>(policy, n, [&](std::size_t k, std::size_t end) {
+        if constexpr (pack<T>::width > 1)
+            for (constexpr auto W = pack<T>::width; k + W <= end; k += W)
+                pack<T>::store(r + k, Op::template apply<pack<T>>(pack<T>::load(a + k)));
+        LA_PRAGMA_UNSEQ
+        for (; k < end; ++k)
+            r[k] = op(a[k]);
+    });
+}
+
+template <typename T, typename Op, typename ExecutionPolicy>
+void transform(ExecutionPolicy policy, std::size_t n, T const* a, T const* b, T* r, Op op)
+{
+    for_chunks<T>(policy, n, [&](std::size_t k, std::size_t end) {
+        if constexpr (pack<T>::width > 1)
+            for (constexpr auto W = pack<T>::width; k + W <= end; k += W)
+                pack<T>::store(r + k, Op::template apply<pack<T>>(pack<T>::load(a + k), pack<T>::load(b + k)));
+        LA_PRAGMA_UNSEQ
+        for (; k < end; ++k)
+            r[k] = op(a[k], b[k]);
+    });
+}
+
+/// r = a + b
+template <typename T, typename ExecutionPolicy>
+void add(ExecutionPolicy policy, std::size_t n, T const* a, T const* b, T* r)
+{
+    transform(policy, n, a, b, r, plus_op{});
+}
+
+/// r = a - b
+template <typename T, typename ExecutionPolicy>
+void subtract(ExecutionPolicy policy, std::size_t n, T const* a, T const* b, T* r)
+{
+    transform(policy, n, a, b, r, minus_op{});
+}
+
+/// r = -a
+template <typename T, typename ExecutionPolicy>
+void negate(ExecutionPolicy policy, std::size_t n, T const* a, T* r)
+{
+    transform(policy, n, a, r, negate_op{});
+}
+
+/// r = a * s
+template <typename T, typename ExecutionPolicy>
+void scale(ExecutionPolicy policy, std::size_t n, T const* a, T s, T* r)
+{
+    for_chunks<T>(policy, n, [&](std::size_t k, std::size_t end) {
+        if constexpr (pack<T>::width > 1)
+        {
+            auto const ss = pack<T>::broadcast(s);
+            for (constexpr auto W = pack<T>::width; k + W <= end; k += W)
+                pack<T>::store(r + k, pack<T>::mul(pack<T>::load(a + k), ss));
+        }
+        LA_PRAGMA_UNSEQ
+        for (; k < end; ++k)
+            r[k] = a[k] * s;
+    });
+}
+
+/// r = a / s
+template <typename T, typename ExecutionPolicy>
+void divide(ExecutionPolicy policy, std::size_t n, T const* a, T s, T* r)
+{
+    for_chunks<T>(policy, n, [&](std::size_t k, std::size_t end) {
+        if constexpr (pack<T>::width > 1)
+        {
+            auto const ss = pack<T>::broadcast(s);
+            for (constexpr auto W = pack<T>::width; k + W <= end; k += W)
+                pack<T>::store(r + k, pack<T>::div(pack<T>::load(a + k), ss));
+        }
+        LA_PRAGMA_UNSEQ
+        for (; k < end; ++k)
+            r[k] = a[k] / s;
+    });
+}
+
+/// y = y + s * x
+template <typename T>
+void axpy(std::size_t n, T s, T const* x, T* y) noexcept
+{
+    std::size_t k = 0;
+    if constexpr (pack<T>::width > 1)
+    {
+        auto const ss = pack<T>::broadcast(s);
+        for (constexpr auto W = pack<T>::width; k + W <= n; k += W)
+            pack<T>::store(y + k, pack<T>::add(pack<T>::load(y + k), pack<T>::mul(ss, pack<T>::load(x + k))));
+    }
+    LA_PRAGMA_UNSEQ
+    for (; k < n; ++k)
+        y[k] = y[k] + s * x[k];
+}
+
+// ---------------------------------------------------------------------------------------------------
+// Dot product
+
+/// Number of partial sums the dot product accumulates into, independent of the instruction set.
+constexpr inline std::size_t dot_lanes = 16;
+
+/// Number of elements the dot product sums up per block, independent of the number of threads.
+constexpr inline std::size_t dot_block_size = std::size_t{1} << 16;
+
+/// Dot product of at most dot_block_size elements, see dot().
+template <typename T>
+T dot_block(std::size_t n, T const* a, T const* b) noexcept
+{
+    T lanes[dot_lanes] = {};
+    std::size_t k = 0;
+
+    if constexpr (pack<T>::width > 1)
+    {
+        using P = pack<T>;
+        constexpr auto W = P::width;
+        constexpr auto R = dot_lanes / W;
+        static_assert(dot_lanes % W == 0);
+
+        typename P::type acc[R];
+        for (std::size_t r = 0; r < R; ++r)
+            acc[r] = P::broadcast(T{});
+
+        for (; k + dot_lanes <= n; k += dot_lanes)
+            for (std::size_t r = 0; r < R; ++r)
+                acc[r] = P::add(acc[r], P::mul(P::load(a + k + r * W), P::load(b + k + r * W)));
+
+        for (std::size_t r = 0; r < R; ++r)
+            P::store(lanes + r * W, acc[r]);
+    }
+    else
+    {
+        for (; k + dot_lanes <= n; k += dot_lanes)
+            for (std::size_t l = 0; l < dot_lanes; ++l)
+                lanes[l] = lanes[l] + a[k + l] * b[k + l];
+    }
+
+    for (auto const k0 = k; k < n; ++k)
+        lanes[k - k0] = lanes[k - k0] + a[k] * b[k];
+
+    for (std::size_t w = dot_lanes / 2; w > 0; w /= 2)
+        for (std::size_t l = 0; l < w; ++l)
+            lanes[l] = lanes[l] + lanes[l + w];
+
+    return lanes[0];
+}
+
+/**
+ * Dot product of a and b, with n elements each.
+ *
+ * Summation order: the elements are split into blocks of dot_block_size. Within a block, element k
+ * is added to partial sum (k mod dot_lanes), in order of k, and the partial sums are then added
+ * pairwise (lane l + lane l + 8, then l + 4, l + 2, l + 1). The block results are added in block order.
+ *
+ * This order does not depend on the instruction set, the execution policy, or the number of
+ * threads, thus the result is reproducible bit-by-bit (as long as the compiler is not allowed to
+ * contract the multiplication and addition into FMA instructions, e.g. via -ffast-math).
+ */
+template <typename T, typename ExecutionPolicy>
+T dot(ExecutionPolicy, std::size_t n, T const* a, T const* b)
+{
+    auto const blocks = (n + dot_block_size - 1) / dot_block_size;
+    auto const block = [&](std::size_t i) {
+        auto const offset = i * dot_block_size;
+        return dot_block(std::min(dot_block_size, n - offset), a + offset, b + offset);
+    };
+
+    auto result = T{};
+    if constexpr (std::is_same_v<ExecutionPolicy, execution::parallel_policy>)
+    {
+        auto partials = std::vector<T>(blocks);
+        thread_pool::global().parallel_for(blocks, 1, [&](std::size_t _begin, std::size_t _end) {
+            for (auto i = _begin; i < _end; ++i)
+                partials[i] = block(i);
+        });
+        for (auto const& partial : partials)
+            result = result + partial;
+    }
+    else
+    {
+        for (std::size_t i = 0; i < blocks; ++i)
+            result = result + block(i);
+    }
+    return result;
+}
+
+} // end namespace simd
+
+// ---------------------------------------------------------------------------------------------------
+// Detection of operands the element-wise kernels apply to.
+
+template <typename ET, typename = void> struct has_writable_span : public std::false_type {};
+template <typename ET> struct has_writable_span<ET, std::enable_if_t<has_span_v<ET>>>
+    : public std::bool_constant<!std::is_const_v<typename span_type_t<ET>::element_type>> {};
+
+/// Tests whether the engines all have a span of the same arithmetic value type,
+/// so that operations on them may run as flat loops over their storage.
+template <typename ET, typename... ETs>
+constexpr inline bool has_flat_storage_v = has_span_v<ET> && (has_span_v<ETs> && ...)
+                                        && std::is_arithmetic_v<typename ET::value_type>
+                                        && (std::is_same_v<typename ET::value_type, typename ETs::value_type> && ...);
+
+/// Tests whether element-wise operations of the operand engines ETs into the result engine ETR
+/// may run as flat loops, see has_flat_storage_v.
+template <typename ETR, typename... ETs>
+constexpr inline bool is_flat_compatible_v = has_writable_span<ETR>::value && has_flat_storage_v<ETR, ETs...>;
+
+/// Tests whether the spans all have contiguous storage of the same shape and layout,
+/// i.e. element k of each span's data() denotes the same (i, j).
+template <typename T, typename... Spans>
+constexpr bool is_flat(matrix_span<T> const& a, Spans const&... rest) noexcept
+{
+    return a.is_contiguous() && ((rest.is_contiguous()
+                                  && rest.rows() == a.rows() && rest.columns() == a.columns()
+                                  && rest.row_stride() == a.row_stride()
+                                  && rest.column_stride() == a.column_stride()) && ...);
+}
+
+template <typename T, typename... Spans>
+constexpr bool is_flat(vector_span<T> const& a, Spans const&... rest) noexcept
+{
+    return a.is_contiguous() && ((rest.is_contiguous() && rest.size() == a.size()) && ...);
+}
+
+/**
+ * Invokes kernel(policy, n, r, a...) for the runs of n contiguous elements of the span r, and
+ * the pointers a... to the same elements of the spans a..., which all have the same shape.
+ *
+ * Flat spans are a single run. Padded matrices (i.e. with a leading dimension larger than their
+ * rows) are visited row by row, or column by column, if they all share that layout.
+ *
+ * @return false if the layouts of the spans differ, without invoking kernel.
+ */
+template <typename ExecutionPolicy, typename Kernel, typename T, typename... Ts>
+bool for_each_run(ExecutionPolicy policy, Kernel const& kernel, vector_span<T> r, vector_span<Ts>... a)
+{
+    if (!is_flat(r, a...))
+        return false;
+
+    kernel(policy, r.size(), r.data(), a.data()...);
+    return true;
+}
+
+template <typename ExecutionPolicy, typename Kernel, typename T, typename... Ts>
+bool for_each_run(ExecutionPolicy policy, Kernel const& kernel, matrix_span<T> r, matrix_span<Ts>... a)
+{
+    if (is_flat(r, a...))
+        kernel(policy, r.rows() * r.columns(), r.data(), a.data()...);
+    else if (r.is_row_major() && (a.is_row_major() && ...))
+        for_each(policy, times(r.rows()), [&](auto i) { kernel(execution::seq, r.columns(), r.row(i).data(), a.row(i).data()...); });
+    else if (r.is_column_major() && (a.is_column_major() && ...))
+        for_each(policy, times(r.columns()), [&](auto j) { kernel(execution::seq, r.rows(), r.column(j).data(), a.column(j).data()...); });
+    else
+        return false;
+    return true;
+}
+
+} // end namespace
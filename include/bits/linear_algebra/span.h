@@ -0,0 +1,183 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+/**
+ * EXT: Non-owning view of the storage of a vector engine, with elements `stride()` apart.
+ *
+ * This is what the span_type of the vector engines (and of the row and column views) refers to.
+ */
+template <class T>
+class vector_span
+{
+  public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using pointer = T*;
+    using reference = T&;
+    using size_type = std::size_t;
+
+    constexpr vector_span() noexcept = default;
+    constexpr vector_span(pointer _data, size_type _size, size_type _stride = 1) noexcept :
+        data_{_data}, size_{_size}, stride_{_stride}
+    {}
+
+    template <class U, std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>, int> = 0>
+    constexpr vector_span(vector_span<U> const& _other) noexcept :
+        data_{_other.data()}, size_{_other.size()}, stride_{_other.stride()}
+    {}
+
+    constexpr pointer data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr size_type stride() const noexcept { return stride_; }
+
+    /// Tests whether the elements are adjacent in memory, i.e. [data(), data() + size()).
+    constexpr bool is_contiguous() const noexcept { return stride_ == 1 || size_ <= 1; }
+
+    constexpr reference operator()(size_type i) const noexcept
+    {
+        assert(i < size_);
+        return data_[i * stride_];
+    }
+
+  private:
+    pointer data_ = nullptr;
+    size_type size_ = 0;
+    size_type stride_ = 1;
+};
+
+/**
+ * EXT: Non-owning strided two-dimensional view of the storage of a matrix engine.
+ *
+ * Element (i, j) is at `data()[i * row_stride() + j * column_stride()]`. Row-major storage has a
+ * column stride of 1 and its leading dimension (the column capacity of the engine) as row stride,
+ * while a transposed view of it simply exchanges both strides.
+ *
+ * This is the layout BLAS-style kernels (such as the GEMM kernel) operate on directly.
+ */
+template <class T>
+class matrix_span
+{
+  public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using pointer = T*;
+    using reference = T&;
+    using size_type = std::size_t;
+    using size_tuple = std::tuple<size_type, size_type>;
+
+    constexpr matrix_span() noexcept = default;
+    constexpr matrix_span(pointer _data, size_type _rows, size_type _columns,
+                          size_type _rowStride, size_type _columnStride = 1) noexcept :
+        data_{_data}, rows_{_rows}, columns_{_columns}, row_stride_{_rowStride}, column_stride_{_columnStride}
+    {}
+
+    template <class U, std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>, int> = 0>
+    constexpr matrix_span(matrix_span<U> const& _other) noexcept :
+        data_{_other.data()},
+        rows_{_other.rows()},
+        columns_{_other.columns()},
+        row_stride_{_other.row_stride()},
+        column_stride_{_other.column_stride()}
+    {}
+
+    constexpr pointer data() const noexcept { return data_; }
+    constexpr size_type rows() const noexcept { return rows_; }
+    constexpr size_type columns() const noexcept { return columns_; }
+    constexpr size_tuple size() const noexcept { return {rows_, columns_}; }
+    constexpr size_type row_stride() const noexcept { return row_stride_; }
+    constexpr size_type column_stride() const noexcept { return column_stride_; }
+
+    /// Tests whether the elements of each row are adjacent in memory.
+    constexpr bool is_row_major() const noexcept { return column_stride_ == 1; }
+
+    /// Tests whether the elements of each column are adjacent in memory.
+    constexpr bool is_column_major() const noexcept { return row_stride_ == 1; }
+
+    /// Distance between two consecutive rows (row-major) or columns (column-major), in elements.
+    constexpr size_type leading_dimension() const noexcept { return is_row_major() ? row_stride_ : column_stride_; }
+
+    /// Tests whether all elements are adjacent in memory, i.e. [data(), data() + rows() * columns()).
+    constexpr bool is_contiguous() const noexcept
+    {
+        return (is_row_major() && (row_stride_ == columns_ || rows_ <= 1))
+            || (is_column_major() && (column_stride_ == rows_ || columns_ <= 1));
+    }
+
+    constexpr reference operator()(size_type i, size_type j) const noexcept
+    {
+        assert(i < rows_ && j < columns_);
+        return data_[i * row_stride_ + j * column_stride_];
+    }
+
+    constexpr vector_span<T> row(size_type i) const noexcept
+    {
+        return vector_span<T>(data_ + i * row_stride_, columns_, column_stride_);
+    }
+
+    constexpr vector_span<T> column(size_type j) const noexcept
+    {
+        return vector_span<T>(data_ + j * column_stride_, rows_, row_stride_);
+    }
+
+    /// Block of rn rows and cn columns, starting at (ri, ci).
+    constexpr matrix_span subspan(size_type ri, size_type rn, size_type ci, size_type cn) const noexcept
+    {
+        assert(ri + rn <= rows_ && ci + cn <= columns_);
+        return matrix_span(data_ + ri * row_stride_ + ci * column_stride_, rn, cn, row_stride_, column_stride_);
+    }
+
+    constexpr matrix_span transposed() const noexcept
+    {
+        return matrix_span(data_, columns_, rows_, column_stride_, row_stride_);
+    }
+
+  private:
+    pointer data_ = nullptr;
+    size_type rows_ = 0;
+    size_type columns_ = 0;
+    size_type row_stride_ = 0;
+    size_type column_stride_ = 1;
+};
+
+namespace detail { // {{{
+    template <typename ET, typename = void> struct span_type_of { using type = void; };
+    template <typename ET> struct span_type_of<ET, std::void_t<typename ET::span_type>> {
+        using type = typename ET::span_type;
+    };
+
+    template <typename ET, typename = void> struct const_span_type_of { using type = void; };
+    template <typename ET> struct const_span_type_of<ET, std::void_t<typename ET::const_span_type>> {
+        using type = typename ET::const_span_type;
+    };
+} // }}}
+
+/// EXT: span type of engine ET, or void if its storage cannot be viewed as a (strided) span.
+template <typename ET> using span_type_t = typename detail::span_type_of<ET>::type;
+template <typename ET> using const_span_type_t = typename detail::const_span_type_of<ET>::type;
+
+/// EXT: tests whether the storage of engine ET can be accessed via span().
+template <typename ET> constexpr inline bool has_span_v = !std::is_void_v<span_type_t<ET>>;
+
+} // end namespace
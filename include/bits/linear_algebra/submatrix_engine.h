@@ -22,21 +22,26 @@ namespace LINEAR_ALGEBRA_NAMESPACE {
 template <typename ET, typename MCT>
 class matrix_view_engine<ET, MCT, submatrix_view_tag>
 {
+    // writable (and resizable) engines are writable through a view that is not read-only
+    constexpr static bool is_writable_view = !is_readonly_engine_v<ET> && !std::is_same_v<MCT, readable_matrix_engine_tag>;
+
   public:
     //- Types
     //
     using engine_category = MCT;
     using element_type = typename ET::element_type;
     using value_type = typename ET::value_type;
-    using pointer = std::conditional_t<is_writable_engine_v<ET>, value_type*, value_type const*>;
+    using pointer = std::conditional_t<is_writable_view, value_type*, value_type const*>;
     using const_pointer = typename ET::const_pointer;
-    using reference = std::conditional_t<is_writable_engine_v<ET>, value_type&, value_type const&>;
+    using reference = std::conditional_t<is_writable_view, value_type&, value_type const&>;
     using const_reference = typename ET::const_reference;
     using difference_type = typename ET::difference_type;
     using size_type = typename ET::size_type;
     using size_tuple = typename ET::size_tuple;
-    using span_type = TODO; // implementation-defined ; (see note )
-    using const_span_type = TODO; // implementation-defined ; (see note )
+    // The view removes a band of rows and columns (see the constructor), which in general
+    // cannot be described by a single strided span of the underlying storage.
+    using span_type = void;
+    using const_span_type = void;
 
     //- Construct/copy/destroy
     //
@@ -77,10 +82,6 @@ class matrix_view_engine<ET, MCT, submatrix_view_tag>
                 : (*engine_)(i + rn_, j + cn_);
     }
 
-    //- Data access
-    //
-    constexpr span_type span() const noexcept; // TODO
-
     //- Modifiers
     //
     constexpr void swap(matrix_view_engine& rhs)
@@ -106,9 +107,9 @@ class matrix_view_engine<ET, MCT, submatrix_view_tag>
     std::vector<size_type> columnMapping_;
 };
 
-template <typename T, size_t R, size_t C, typename MCT>
-class matrix_view_engine<fs_matrix_engine<T, R, C>, MCT, submatrix_view_tag> {
-    using ET = fs_matrix_engine<T, R, C>;
+template <typename T, size_t R, size_t C, typename L, typename MCT>
+class matrix_view_engine<fs_matrix_engine<T, R, C, L>, MCT, submatrix_view_tag> {
+    using ET = fs_matrix_engine<T, R, C, L>;
   public:
     //- Types
     //
@@ -122,8 +123,10 @@ class matrix_view_engine<fs_matrix_engine<T, R, C>, MCT, submatrix_view_tag> {
     using difference_type = typename ET::difference_type;
     using size_type = typename ET::size_type;
     using size_tuple = typename ET::size_tuple;
-    using span_type = TODO; // implementation-defined ; (see note )
-    using const_span_type = TODO; // implementation-defined ; (see note )
+    // The view removes a band of rows and columns (see the constructor), which in general
+    // cannot be described by a single strided span of the underlying storage.
+    using span_type = void;
+    using const_span_type = void;
 
     //- Construct/copy/destroy
     //
@@ -174,10 +177,6 @@ class matrix_view_engine<fs_matrix_engine<T, R, C>, MCT, submatrix_view_tag> {
         return (*engine_)(xi, xj);
     }
 
-    //- Data access
-    //
-    constexpr span_type span() const noexcept; // TODO
-
     //- Modifiers
     //
     constexpr void swap(matrix_view_engine& rhs)
@@ -199,16 +198,16 @@ class matrix_view_engine<fs_matrix_engine<T, R, C>, MCT, submatrix_view_tag> {
     std::array<size_type, C> columnMapping_{};
 };
 
-template <typename T, size_t R, size_t C, typename MCT>
+template <typename T, size_t R, size_t C, typename L, typename MCT>
 class matrix_view_engine<
     matrix_view_engine<
-        fs_matrix_engine<T, R, C>, MCT,
+        fs_matrix_engine<T, R, C, L>, MCT,
         submatrix_view_tag
     >,
     MCT,
     submatrix_view_tag
 > {
-    using ET = matrix_view_engine<fs_matrix_engine<T, R, C>, MCT, submatrix_view_tag>;
+    using ET = matrix_view_engine<fs_matrix_engine<T, R, C, L>, MCT, submatrix_view_tag>;
   public:
     //- Types
     //
@@ -222,8 +221,10 @@ class matrix_view_engine<
     using difference_type = typename ET::difference_type;
     using size_type = typename ET::size_type;
     using size_tuple = typename ET::size_tuple;
-    using span_type = TODO; // implementation-defined ; (see note )
-    using const_span_type = TODO; // implementation-defined ; (see note )
+    // The view removes a band of rows and columns (see the constructor), which in general
+    // cannot be described by a single strided span of the underlying storage.
+    using span_type = void;
+    using const_span_type = void;
 
     //- Construct/copy/destroy
     //
@@ -292,10 +293,6 @@ class matrix_view_engine<
         return (*engine_)(xi, xj);
     }
 
-    //- Data access
-    //
-    constexpr span_type span() const noexcept; // TODO
-
     //- Modifiers
     //
     constexpr void swap(matrix_view_engine& rhs)
@@ -15,6 +15,9 @@
 #pragma once
 
 #include "base.h"
+#include "execution.h"
+#include "simd.h"
+#include "unrolled_kernel.h"
 #include "operation_traits_selector.h"
 #include "dr_matrix_engine.h"
 
@@ -59,13 +62,30 @@ struct matrix_subtraction_traits<OT, vector<ET1, OT1>, vector<ET2, OT2>>
     using result_type = vector<engine_type, op_traits>;
     constexpr static result_type subtract(vector<ET1, OT1> const& v1, vector<ET2, OT2> const& v2)
     {
-        result_type v3{};
-
-        if constexpr (is_resizable_engine_v<engine_type>)
-            v3.resize(v1.size());
+        return subtract(execution_policy_t<OT>{}, v1, v2);
+    }
 
-        for (decltype(v1.size()) i = 0; i < v1.size(); ++i)
-            v3(i) = v1(i) - v2(i);
+    template <class ExecutionPolicy>
+    constexpr static result_type subtract(ExecutionPolicy policy, vector<ET1, OT1> const& v1, vector<ET2, OT2> const& v2)
+    {
+        auto v3 = detail::make_uninitialized<result_type>(v1.size());
+
+        if constexpr (detail::is_flat_compatible_v<engine_type, ET1, ET2>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const r = v3.span();
+                auto const a = v1.span();
+                auto const b = v2.span();
+                auto const kernel = [](auto p, std::size_t n, auto* x, auto const* y, auto const* z) {
+                    detail::simd::subtract(p, n, y, z, x);
+                };
+                if (detail::for_each_run(policy, kernel, r, a, b))
+                    return v3;
+            }
+        }
+
+        detail::for_each(policy, detail::times(v1.size()), [&](auto i) { v3(i) = v1(i) - v2(i); });
         return v3;
     }
 };
@@ -78,15 +98,39 @@ struct matrix_subtraction_traits<OT, matrix<ET1, OT1>, matrix<ET2, OT2>>
     using result_type = matrix<engine_type, op_traits>;
     constexpr static result_type subtract(matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
     {
-        using size_type = std::size_t;
-        result_type m{};
-
-        if constexpr (is_resizable_engine_v<engine_type>)
-            m.resize(m1.rows(), m1.columns());
+        return subtract(execution_policy_t<OT>{}, m1, m2);
+    }
 
-        for (size_type i = 0; i < m1.rows(); ++i)
-            for (size_type j = 0; j < m1.columns(); ++j)
-                m(i, j) = m1(i, j) - m2(i, j);
+    template <class ExecutionPolicy>
+    constexpr static result_type subtract(ExecutionPolicy policy, matrix<ET1, OT1> const& m1, matrix<ET2, OT2> const& m2)
+    {
+        auto m = detail::make_uninitialized<result_type>(m1.rows(), m1.columns());
+
+        if constexpr (detail::is_unrollable_v<engine_type, ET1, ET2>)
+        {
+            detail::unrolled_assign(m, [&](auto i, auto j) { return m1(i, j) - m2(i, j); });
+            return m;
+        }
+        else if constexpr (detail::is_flat_compatible_v<engine_type, ET1, ET2>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                auto const r = m.span();
+                auto const a = m1.span();
+                auto const b = m2.span();
+                auto const kernel = [](auto p, std::size_t n, auto* x, auto const* y, auto const* z) {
+                    detail::simd::subtract(p, n, y, z, x);
+                };
+                if (detail::for_each_run(policy, kernel, r, a, b))
+                    return m;
+            }
+        }
+
+        using detail::times;
+        detail::for_each(policy, times(m1.rows()) * times(m1.columns()), [&](auto ij) {
+            auto const [i, j] = ij;
+            m(i, j) = m1(i, j) - m2(i, j);
+        });
 
         return m;
     }
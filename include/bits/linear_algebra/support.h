@@ -185,7 +185,9 @@ struct _Times2D
     using iterator = _Times2DIerator<I, T1, T2>;
 
     constexpr std::size_t size() const noexcept { return first.size() * second.size(); }
-    constexpr auto operator[](std::size_t i) const noexcept { return second[i % second.size()]; }
+    constexpr std::tuple<T1, T2> operator[](std::size_t i) const noexcept {
+        return {first[i / second.size()], second[i % second.size()]};
+    }
 
     constexpr iterator begin() const noexcept { return iterator{first, second, true}; }
     constexpr iterator end() const noexcept { return iterator{first, second, false}; }
@@ -311,7 +313,7 @@ constexpr T reduce(Container&& _container, T&& _init, BinaryOp _binaryOp)
     return result;
 }
 
-// TODO: each version with ExecutionPolicy
+// The overloads of the above for an execution policy are in execution.h.
 
 namespace impl { // {{{
     template <typename Container>
@@ -15,30 +15,69 @@
 #pragma once
 
 #include "base.h"
+#include "span.h"
+
+#include <type_traits>
+#include <utility>
 
 namespace LINEAR_ALGEBRA_NAMESPACE {
 
+namespace detail { // {{{
+    /// Engine type of the transpose of a matrix with engine type ET, used for the engine promotion
+    /// of transpose views. Fixed-size engines exchange their extents, resizable ones stay as is.
+    template <typename ET> struct transposed_engine { using type = ET; };
+
+    template <typename T, std::size_t R, std::size_t C, typename L>
+    struct transposed_engine<fs_matrix_engine<T, R, C, L>> { using type = fs_matrix_engine<T, C, R, L>; };
+
+    template <typename ET, typename MCT>
+    struct transposed_engine<transpose_engine<ET, MCT>> { using type = ET; };
+
+    template <typename ET> using transposed_engine_t = typename transposed_engine<ET>::type;
+
+    /// Tests whether an expiring engine of type ET transposes into the other layout of its very
+    /// storage (see fs_matrix_engine::transposed()), i.e. without moving any of its elements.
+    template <typename ET, typename = void> struct has_layout_transpose : public std::false_type {};
+
+    template <typename ET>
+    struct has_layout_transpose<ET, std::void_t<decltype(std::declval<ET>().transposed())>> : public std::true_type {};
+
+    template <typename ET> constexpr inline bool has_layout_transpose_v = has_layout_transpose<ET>::value;
+
+    /// Tests whether VT is the engine type of a transpose view of a matrix with engine type ET.
+    template <typename VT, typename ET> struct is_transpose_of : public std::false_type {};
+
+    template <typename ET, typename MCT>
+    struct is_transpose_of<transpose_engine<ET, MCT>, ET> : public std::true_type {};
+
+    template <typename VT, typename ET> constexpr inline bool is_transpose_of_v = is_transpose_of<VT, ET>::value;
+} // }}}
+
 // 6.4.6
 template <class ET, class MCT>
 class matrix_view_engine<ET, MCT, transpose_view_tag> {
   private:
     ET* engine_{};
 
+    // Read-only views access the elements through the const engine, as engines with proxy
+    // references (such as csr_matrix_engine) only hand out const_reference from there.
+    constexpr static bool is_readonly_view = std::is_same_v<MCT, readable_matrix_engine_tag>;
+
   public:
     //- Types
     //
     using engine_category = MCT;
     using element_type = typename ET::element_type;
     using value_type = typename ET::value_type;
-    using pointer = std::conditional_t<is_readonly_engine_v<ET>, typename ET::const_pointer, typename ET::pointer>;
+    using pointer = std::conditional_t<is_readonly_engine_v<ET> || is_readonly_view, typename ET::const_pointer, typename ET::pointer>;
     using const_pointer = typename ET::const_pointer;
-    using reference = std::conditional_t<is_readonly_engine_v<ET>, typename ET::const_reference, typename ET::reference>;
+    using reference = std::conditional_t<is_readonly_engine_v<ET> || is_readonly_view, typename ET::const_reference, typename ET::reference>;
     using const_reference = typename ET::const_reference;
     using difference_type = typename ET::difference_type;
     using size_type = typename ET::size_type;
     using size_tuple = typename ET::size_tuple;
-    using span_type = TODO; // implementation-defined ; (see note )
-    using const_span_type = TODO; // implementation-defined ; (see note )
+    using span_type = std::conditional_t<has_span_v<ET>, matrix_span<std::remove_pointer_t<pointer>>, void>;
+    using const_span_type = std::conditional_t<has_span_v<ET>, matrix_span<element_type const>, void>;
 
     //- Construct/copy/destroy
     //
@@ -65,12 +104,19 @@ class matrix_view_engine<ET, MCT, transpose_view_tag> {
     //
     constexpr reference operator()(size_type i, size_type j) const
     {
-        return (*engine_)(j, i);
+        if constexpr (is_readonly_view)
+            return std::as_const(*engine_)(j, i);
+        else
+            return (*engine_)(j, i);
     }
 
     //- Data access
     //
-    constexpr span_type span() const noexcept; // TODO
+    /// Span of the underlying engine with rows and columns (and their strides) exchanged.
+    constexpr span_type span() const noexcept { return engine_->span().transposed(); }
+
+    /// EXT: The engine viewed in transposed order.
+    constexpr ET const* viewed_engine() const noexcept { return engine_; }
 
     //- Modifiers
     //
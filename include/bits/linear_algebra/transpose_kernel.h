@@ -0,0 +1,154 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+#include "span.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace LINEAR_ALGEBRA_NAMESPACE::detail {
+
+/// Edge length of the tiles the recursive transpose kernels stop splitting at.
+/// Source and destination tile of 32 x 32 doubles take 16 KiB, i.e. they fit into L1 together.
+constexpr inline std::size_t transpose_tile = 32;
+
+/**
+ * Copies the m x n matrix A to B, where both are given by a pointer to their first element plus
+ * row and column strides.
+ *
+ * If both have the same layout, rows (or columns) are copied sequentially. Otherwise, i.e. for
+ * a transpose, the matrix is split cache-obliviously along its longer side until the tiles fit
+ * into L1, so that every cache line of A and B is only loaded once.
+ */
+template <typename T>
+void copy_blocked(std::size_t m, std::size_t n,
+                  T const* a, std::size_t rsa, std::size_t csa,
+                  T* b, std::size_t rsb, std::size_t csb)
+{
+    if (csa == 1 && csb == 1)
+    {
+        for (std::size_t i = 0; i < m; ++i)
+            std::copy(a + i * rsa, a + i * rsa + n, b + i * rsb);
+    }
+    else if (rsa == 1 && rsb == 1)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+            std::copy(a + j * csa, a + j * csa + m, b + j * csb);
+    }
+    else if (m <= transpose_tile && n <= transpose_tile)
+    {
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+                b[i * rsb + j * csb] = a[i * rsa + j * csa];
+    }
+    else if (m >= n)
+    {
+        auto const h = m / 2;
+        copy_blocked(h, n, a, rsa, csa, b, rsb, csb);
+        copy_blocked(m - h, n, a + h * rsa, rsa, csa, b + h * rsb, rsb, csb);
+    }
+    else
+    {
+        auto const h = n / 2;
+        copy_blocked(m, h, a, rsa, csa, b, rsb, csb);
+        copy_blocked(m, n - h, a + h * csa, rsa, csa, b + h * csb, rsb, csb);
+    }
+}
+
+/// Swaps A(i, j) with A(j, i) for all i in [i0, i0 + m) and j in [j0, j0 + n), where both
+/// ranges do not overlap, recursively split like copy_blocked().
+template <typename T>
+void swap_transposed_blocked(std::size_t i0, std::size_t m, std::size_t j0, std::size_t n,
+                             T* a, std::size_t rs, std::size_t cs)
+{
+    if (m <= transpose_tile && n <= transpose_tile)
+    {
+        for (auto i = i0; i < i0 + m; ++i)
+            for (auto j = j0; j < j0 + n; ++j)
+                std::swap(a[i * rs + j * cs], a[j * rs + i * cs]);
+    }
+    else if (m >= n)
+    {
+        auto const h = m / 2;
+        swap_transposed_blocked(i0, h, j0, n, a, rs, cs);
+        swap_transposed_blocked(i0 + h, m - h, j0, n, a, rs, cs);
+    }
+    else
+    {
+        auto const h = n / 2;
+        swap_transposed_blocked(i0, m, j0, h, a, rs, cs);
+        swap_transposed_blocked(i0, m, j0 + h, n - h, a, rs, cs);
+    }
+}
+
+/// Transposes the n x n matrix A in place, by recursively transposing the two diagonal blocks
+/// and exchanging the two off-diagonal blocks.
+template <typename T>
+void transpose_in_place_blocked(std::size_t n, T* a, std::size_t rs, std::size_t cs)
+{
+    struct diagonal {
+        T* a;
+        std::size_t rs;
+        std::size_t cs;
+
+        void operator()(std::size_t i0, std::size_t n) const
+        {
+            if (n <= transpose_tile)
+            {
+                for (auto i = i0; i < i0 + n; ++i)
+                    for (auto j = i + 1; j < i0 + n; ++j)
+                        std::swap(a[i * rs + j * cs], a[j * rs + i * cs]);
+                return;
+            }
+            auto const h = n / 2;
+            (*this)(i0, h);
+            (*this)(i0 + h, n - h);
+            swap_transposed_blocked(i0 + h, n - h, i0, h, a, rs, cs);
+        }
+    };
+    diagonal{a, rs, cs}(0, n);
+}
+
+/**
+ * Copies the elements of the span src to dst, which must have the same shape.
+ *
+ * src may be a view of dst's engine itself (e.g. in `m = m.t()`), in which case the copy is
+ * either a no-op or, for a square matrix, an in-place transpose.
+ */
+template <typename T>
+void copy(matrix_span<T const> src, matrix_span<T> dst)
+{
+    assert(src.rows() == dst.rows() && src.columns() == dst.columns());
+
+    if (src.data() == dst.data())
+    {
+        if (src.row_stride() == dst.row_stride() && src.column_stride() == dst.column_stride())
+            return;
+
+        assert(dst.rows() == dst.columns() && src.row_stride() == dst.column_stride());
+        transpose_in_place_blocked(dst.rows(), dst.data(), dst.row_stride(), dst.column_stride());
+        return;
+    }
+
+    copy_blocked(src.rows(), src.columns(),
+                 src.data(), src.row_stride(), src.column_stride(),
+                 dst.data(), dst.row_stride(), dst.column_stride());
+}
+
+} // end namespace
@@ -0,0 +1,225 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+#include "csr_matrix_engine.h"
+#include "execution.h"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace LINEAR_ALGEBRA_NAMESPACE {
+
+/**
+ * EXT: Collects (i, j, value) triplets (coordinate format) in any order, and assembles them into
+ * compressed sparse storage in a few linear passes.
+ *
+ * Triplets addressing the same element are summed up, as is common for finite-element assembly.
+ * Building sorts the triplets by two stable counting sort passes (by minor, then major index),
+ * thus takes O(nnz + rows + columns) time and memory, and is independent of insertion order.
+ *
+ * Assembly may be done in parallel via assemble(), with each thread appending to its own buffer.
+ */
+template <class T, class AT = std::allocator<T>>
+class triplet_builder
+{
+  public:
+    using value_type = std::remove_cv_t<T>;
+    using allocator_type = AT;
+    using engine_type = csr_matrix_engine<T, AT>;
+    using size_type = typename engine_type::size_type;
+    using index_vector = typename engine_type::index_vector;
+    using value_vector = typename engine_type::value_vector;
+
+    /// Triplet buffer that is filled by a single thread.
+    class buffer {
+      public:
+        void add(size_type i, size_type j, value_type const& v)
+        {
+            assert(i < rowCount_ && j < columnCount_);
+            rows_.push_back(i);
+            columns_.push_back(j);
+            values_.push_back(v);
+        }
+
+        void reserve(size_type n)
+        {
+            rows_.reserve(n);
+            columns_.reserve(n);
+            values_.reserve(n);
+        }
+
+        size_type size() const noexcept { return values_.size(); }
+
+      private:
+        friend class triplet_builder;
+
+        buffer(size_type rows, size_type cols) : rowCount_{rows}, columnCount_{cols} {}
+
+        size_type rowCount_;
+        size_type columnCount_;
+        index_vector rows_;
+        index_vector columns_;
+        value_vector values_;
+    };
+
+    triplet_builder(size_type rows, size_type cols) : rows_{rows}, columns_{cols}, buffers_(1, buffer{rows, cols}) {}
+
+    size_type rows() const noexcept { return rows_; }
+    size_type columns() const noexcept { return columns_; }
+
+    /// Total number of collected triplets, including duplicates.
+    size_type size() const noexcept
+    {
+        size_type n = 0;
+        for (auto const& b : buffers_)
+            n += b.size();
+        return n;
+    }
+
+    void reserve(size_type n) { buffers_.front().reserve(n); }
+
+    void add(size_type i, size_type j, value_type const& v) { buffers_.front().add(i, j, v); }
+
+    void clear() { buffers_.assign(1, buffer{rows_, columns_}); }
+
+    /**
+     * Invokes body(buffer&, k) for each k in [0, count), which adds the triplets of item k
+     * (e.g. the k-th finite element) to the given buffer.
+     *
+     * With execution::par, the items are split into contiguous chunks, each run on its own thread
+     * with its own buffer. Buffers are kept in item order, so the built matrix (including the
+     * rounding of summed duplicates) does not depend on the number of threads.
+     */
+    template <class ExecutionPolicy, class Body>
+    void assemble(ExecutionPolicy, size_type count, Body body)
+    {
+        if constexpr (std::is_same_v<ExecutionPolicy, execution::parallel_policy>)
+        {
+            auto chunks = std::vector<std::pair<size_type, buffer>>{};
+            auto mutex = std::mutex{};
+            detail::thread_pool::global().parallel_for(count, 1, [&](size_type _begin, size_type _end) {
+                auto local = buffer{rows_, columns_};
+                for (auto k = _begin; k < _end; ++k)
+                    body(local, k);
+                auto const _ = std::lock_guard{mutex};
+                chunks.emplace_back(_begin, std::move(local));
+            });
+            std::sort(chunks.begin(), chunks.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+            for (auto& chunk : chunks)
+                buffers_.emplace_back(std::move(chunk.second));
+        }
+        else
+        {
+            for (size_type k = 0; k < count; ++k)
+                body(buffers_.front(), k);
+        }
+    }
+
+    /// Builds the matrix in compressed sparse row format.
+    engine_type build_csr() const { return compress(false); }
+
+    /// Builds the matrix in compressed sparse column format, which is its transpose in CSR format,
+    /// i.e. a columns() x rows() engine (use matrix::t() to access it in the original orientation).
+    engine_type build_csc() const { return compress(true); }
+
+  private:
+    engine_type compress(bool _columnMajor) const
+    {
+        auto const majors = _columnMajor ? columns_ : rows_;
+        auto const minors = _columnMajor ? rows_ : columns_;
+        auto const n = size();
+
+        auto const for_each_triplet = [&](auto const& f) {
+            for (auto const& b : buffers_)
+                for (size_type k = 0; k < b.size(); ++k)
+                    if (_columnMajor)
+                        f(b.columns_[k], b.rows_[k], b.values_[k]);
+                    else
+                        f(b.rows_[k], b.columns_[k], b.values_[k]);
+        };
+
+        // pass 1: stable counting sort by minor index
+        auto minorOffsets = index_vector(minors + 1);
+        for_each_triplet([&](size_type, size_type j, value_type const&) { ++minorOffsets[j + 1]; });
+        for (size_type j = 0; j < minors; ++j)
+            minorOffsets[j + 1] += minorOffsets[j];
+
+        auto byMinorMajor = index_vector(n);
+        auto byMinorMinor = index_vector(n);
+        auto byMinorValue = value_vector(n);
+        for_each_triplet([&](size_type i, size_type j, value_type const& v) {
+            auto const p = minorOffsets[j]++;
+            byMinorMajor[p] = i;
+            byMinorMinor[p] = j;
+            byMinorValue[p] = v;
+        });
+
+        // pass 2: stable counting sort by major index, leaving each major slice sorted by minor index
+        auto offsets = index_vector(majors + 1);
+        for (size_type p = 0; p < n; ++p)
+            ++offsets[byMinorMajor[p] + 1];
+        for (size_type i = 0; i < majors; ++i)
+            offsets[i + 1] += offsets[i];
+
+        auto indices = index_vector(n);
+        auto values = value_vector(n);
+        {
+            auto next = index_vector(offsets.begin(), offsets.end() - 1);
+            for (size_type p = 0; p < n; ++p)
+            {
+                auto const q = next[byMinorMajor[p]]++;
+                indices[q] = byMinorMinor[p];
+                values[q] = std::move(byMinorValue[p]);
+            }
+        }
+
+        // pass 3: sum up duplicates, compacting in place
+        size_type k = 0;
+        for (size_type i = 0; i < majors; ++i)
+        {
+            auto const begin = offsets[i];
+            auto const end = offsets[i + 1];
+            offsets[i] = k;
+            for (auto p = begin; p < end; ++p)
+            {
+                if (k > offsets[i] && indices[k - 1] == indices[p])
+                    values[k - 1] = values[k - 1] + values[p];
+                else
+                {
+                    indices[k] = indices[p];
+                    values[k] = std::move(values[p]);
+                    ++k;
+                }
+            }
+        }
+        offsets[majors] = k;
+        indices.resize(k);
+        values.resize(k);
+
+        return engine_type(majors, minors, std::move(offsets), std::move(indices), std::move(values));
+    }
+
+    size_type rows_;
+    size_type columns_;
+    std::vector<buffer> buffers_;
+};
+
+} // end namespace
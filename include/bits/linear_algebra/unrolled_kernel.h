@@ -0,0 +1,211 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "base.h"
+#include "simd.h"
+#include "span.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Kernels for small fixed-size matrices, whose extents are all template parameters.
+//
+// Instead of walking detail::times() ranges, the loops are expanded at compile time into
+// straight-line code (which the compiler is free to vectorize), and remain usable in constant
+// expressions. At run time, 4x4 float products keep the right operand in four SSE registers.
+
+namespace LINEAR_ALGEBRA_NAMESPACE::detail {
+
+/// Largest extent of the fixed-size matrices whose arithmetic is unrolled, see is_unrollable_v.
+constexpr inline std::size_t max_unrolled_extent = 8;
+
+/// Compile-time extents (and strides of the storage) of fixed-size engines, and of transpose views of these.
+template <typename ET>
+struct fixed_extents {
+    static constexpr bool value = false;
+    static constexpr std::size_t rows = 0;
+    static constexpr std::size_t columns = 0;
+    static constexpr std::size_t row_stride = 0;
+    static constexpr std::size_t column_stride = 0;
+};
+
+template <typename T, std::size_t R, std::size_t C, typename L>
+struct fixed_extents<fs_matrix_engine<T, R, C, L>> {
+    static constexpr bool value = true;
+    static constexpr std::size_t rows = R;
+    static constexpr std::size_t columns = C;
+    static constexpr std::size_t row_stride = std::is_same_v<L, column_major> ? 1 : C;
+    static constexpr std::size_t column_stride = std::is_same_v<L, column_major> ? R : 1;
+};
+
+template <typename T, std::size_t N>
+struct fixed_extents<fs_vector_engine<T, N>> {
+    static constexpr bool value = true;
+    static constexpr std::size_t rows = N;
+    static constexpr std::size_t columns = 1;
+    static constexpr std::size_t row_stride = 1;
+    static constexpr std::size_t column_stride = N;
+};
+
+template <typename ET, typename MCT>
+struct fixed_extents<transpose_engine<ET, MCT>> {
+    static constexpr bool value = fixed_extents<ET>::value;
+    static constexpr std::size_t rows = fixed_extents<ET>::columns;
+    static constexpr std::size_t columns = fixed_extents<ET>::rows;
+    static constexpr std::size_t row_stride = fixed_extents<ET>::column_stride;
+    static constexpr std::size_t column_stride = fixed_extents<ET>::row_stride;
+};
+
+/// Tests whether all engines are of fixed size, with no extent larger than max_unrolled_extent.
+template <typename... ETs>
+constexpr inline bool is_unrollable_v = ((fixed_extents<ETs>::value
+                                          && fixed_extents<ETs>::rows <= max_unrolled_extent
+                                          && fixed_extents<ETs>::columns <= max_unrolled_extent) && ...);
+
+template <typename F, std::size_t... I>
+constexpr void unrolled(F&& f, std::index_sequence<I...>)
+{
+    (f(std::integral_constant<std::size_t, I>{}), ...);
+}
+
+/// Invokes f(std::integral_constant<std::size_t, I>{}) for I = 0, ..., N - 1, unrolled.
+template <std::size_t N, typename F>
+constexpr void unrolled(F&& f)
+{
+    unrolled(f, std::make_index_sequence<N>{});
+}
+
+/// Invokes f(i, j) for all R x C indices, row by row, unrolled.
+template <std::size_t R, std::size_t C, typename F>
+constexpr void unrolled(F&& f)
+{
+    unrolled<R * C>([&](auto ij) {
+        constexpr auto I = decltype(ij)::value;
+        f(std::integral_constant<std::size_t, I / C>{}, std::integral_constant<std::size_t, I % C>{});
+    });
+}
+
+/// Sum of f(k) for k = 0, ..., K - 1, unrolled, accumulated in order starting from T{}.
+template <typename T, std::size_t K, typename F>
+constexpr T unrolled_sum(F&& f)
+{
+    auto acc = T{};
+    unrolled<K>([&](auto k) { acc = acc + f(k); });
+    return acc;
+}
+
+namespace simd {
+#if LA_SIMD_ISA > 0
+    /**
+     * C = A B of 4x4 floats, the four rows of B held in as many SSE registers.
+     *
+     * Row i of C is the linear combination of the rows of B with the elements of row i of A,
+     * hence the rows of B and C must be contiguous (LDB, LDC being their distances),
+     * whereas A is read by its strides. Column-major operands are passed transposed,
+     * i.e. as C^T = B^T A^T.
+     *
+     * The strides are template parameters, as they are known for all fixed-size matrices,
+     * so that the kernel compiles to straight-line code also when not inlined.
+     */
+    template <std::size_t RSA, std::size_t CSA, std::size_t LDB, std::size_t LDC>
+    void multiply_4x4(float const* a, float const* b, float* c) noexcept
+    {
+        __m128 const b0 = _mm_loadu_ps(b);
+        __m128 const b1 = _mm_loadu_ps(b + LDB);
+        __m128 const b2 = _mm_loadu_ps(b + 2 * LDB);
+        __m128 const b3 = _mm_loadu_ps(b + 3 * LDB);
+
+        unrolled<4>([&](auto i) {
+            auto const* ai = a + i * RSA;
+            auto r = _mm_mul_ps(_mm_set1_ps(ai[0]), b0);
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(ai[CSA]), b1));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(ai[2 * CSA]), b2));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(ai[3 * CSA]), b3));
+            _mm_storeu_ps(c + i * LDC, r);
+        });
+    }
+#endif
+}
+
+/// r(i, j) = f(i, j) for all elements of the fixed-size matrix r, e.g. for elementwise operations.
+template <typename MR, typename F>
+constexpr void unrolled_assign(MR& r, F&& f)
+{
+    using extents = fixed_extents<typename MR::engine_type>;
+    unrolled<extents::rows, extents::columns>([&](auto i, auto j) { r(i, j) = f(i, j); });
+}
+
+/// r = a b, for fixed-size matrices r, a and b (or transpose views thereof).
+template <typename MR, typename M1, typename M2>
+constexpr void unrolled_multiply(MR& r, M1 const& a, M2 const& b)
+{
+    using value_type = typename MR::value_type;
+    using extents = fixed_extents<typename MR::engine_type>;
+    constexpr auto K = fixed_extents<typename M1::engine_type>::columns;
+
+#if LA_SIMD_ISA > 0
+    if constexpr (std::is_same_v<value_type, float> && extents::rows == 4 && extents::columns == 4 && K == 4
+                  && has_flat_storage_v<typename MR::engine_type, typename M1::engine_type, typename M2::engine_type>)
+    {
+        using A = fixed_extents<typename M1::engine_type>;
+        using B = fixed_extents<typename M2::engine_type>;
+        if (!is_constant_evaluated())
+        {
+            if constexpr (B::column_stride == 1 && extents::column_stride == 1)
+            {
+                simd::multiply_4x4<A::row_stride, A::column_stride, B::row_stride, extents::row_stride>(
+                    a.span().data(), b.span().data(), r.span().data());
+                return;
+            }
+            else if constexpr (A::row_stride == 1 && extents::row_stride == 1)
+            {
+                simd::multiply_4x4<B::column_stride, B::row_stride, A::column_stride, extents::column_stride>(
+                    b.span().data(), a.span().data(), r.span().data());
+                return;
+            }
+        }
+    }
+#endif
+
+    unrolled<extents::rows, extents::columns>([&](auto i, auto j) {
+        r(i, j) = unrolled_sum<value_type, K>([&](auto k) { return a(i, k) * b(k, j); });
+    });
+}
+
+/// r = a x, for a fixed-size matrix a and vectors r and x.
+template <typename VR, typename M1, typename V2>
+constexpr void unrolled_multiply_vector(VR& r, M1 const& a, V2 const& x)
+{
+    using value_type = typename VR::value_type;
+    using extents = fixed_extents<typename M1::engine_type>;
+    unrolled<extents::rows>([&](auto i) {
+        r(i) = unrolled_sum<value_type, extents::columns>([&](auto j) { return a(i, j) * x(j); });
+    });
+}
+
+/// r = x a, for a fixed-size matrix a and vectors r and x.
+template <typename VR, typename V1, typename M2>
+constexpr void unrolled_vector_multiply(VR& r, V1 const& x, M2 const& a)
+{
+    using value_type = typename VR::value_type;
+    using extents = fixed_extents<typename M2::engine_type>;
+    unrolled<extents::columns>([&](auto j) {
+        r(j) = unrolled_sum<value_type, extents::rows>([&](auto i) { return x(i) * a(i, j); });
+    });
+}
+
+} // end namespace
@@ -15,7 +15,9 @@
 #pragma once
 
 #include "base.h"
+#include "assignment_traits.h"
 #include "dr_vector_engine.h"
+#include "operation_traits_selector.h"
 
 #include <iterator>
 
@@ -59,6 +61,7 @@ class vector {
     template <class ET2, class OT2>
     constexpr vector(vector<ET2, OT2> const& src) //: engine_(src.engine()) {}
     {
+        resize(src.size());
         for (auto i : detail::times(src.size()))
             engine_(i) = src(i);
     }
@@ -66,7 +69,14 @@ class vector {
     constexpr vector(std::initializer_list<U> list) : engine_(list) {}
     constexpr vector(size_type elems) { resize(elems); }
     constexpr vector(size_type elems, size_type elemcap) { resize(elems, elemcap); }
-    constexpr explicit vector(ET&& _engine) : engine_{std::forward<ET>(_engine)} {} // EXT
+    constexpr explicit vector(ET&& _engine) : engine_(std::forward<ET>(_engine)) {} // EXT
+    constexpr explicit vector(uninitialized_t _u) : engine_(_u) {} // EXT, see uninitialized_t
+    constexpr vector(uninitialized_t _u, size_type elems) : engine_(_u, elems) {} // EXT
+
+    // EXT: evaluates a lazy vector expression (see expression.h)
+    template <typename E, typename std::enable_if_t<is_vector_expression_v<E>, int> = 0>
+    constexpr vector(E const& expr) { *this = expr; }
+
     constexpr vector& operator=(vector&&) noexcept = default;
     constexpr vector& operator=(vector const&) = default;
     template <class ET2, class OT2>
@@ -79,6 +89,51 @@ class vector {
         return *this;
     }
 
+    // EXT: evaluates a lazy vector expression (see expression.h) in a single pass over all operands.
+    template <typename E, typename std::enable_if_t<is_vector_expression_v<E>, int> = 0>
+    constexpr vector& operator=(E const& expr)
+    {
+        if constexpr (E::is_fusable)
+        {
+            resize(expr.size());
+            for (auto i : detail::times(size()))
+                engine_(i) = expr(i);
+        }
+        else
+            *this = expr.eval();
+
+        return *this;
+    }
+
+    //- EXT: In-place arithmetic, via the arithmetic assignment traits of the operation traits
+    //  (see assignment_traits.h). These also update writable views, e.g. m.row(i) *= 2.
+    //
+    template <class ET2, class OT2>
+    constexpr vector& operator+=(vector<ET2, OT2> const& rhs)
+    {
+        using op_traits = matrix_operation_traits_selector_t<OT, OT2>;
+        return matrix_addition_assignment_traits_t<op_traits, vector, vector<ET2, OT2>>::add_assign(*this, rhs);
+    }
+
+    template <class ET2, class OT2>
+    constexpr vector& operator-=(vector<ET2, OT2> const& rhs)
+    {
+        using op_traits = matrix_operation_traits_selector_t<OT, OT2>;
+        return matrix_subtraction_assignment_traits_t<op_traits, vector, vector<ET2, OT2>>::subtract_assign(*this, rhs);
+    }
+
+    template <class S2, std::enable_if_t<is_matrix_element_v<S2>, int> = 0>
+    constexpr vector& operator*=(S2 const& s)
+    {
+        return matrix_multiplication_assignment_traits_t<OT, vector, S2>::multiply_assign(*this, s);
+    }
+
+    template <class S2, std::enable_if_t<is_matrix_element_v<S2>, int> = 0>
+    constexpr vector& operator/=(S2 const& s)
+    {
+        return matrix_division_assignment_traits_t<OT, vector, S2>::divide_assign(*this, s);
+    }
+
     //- Iterators
     //
     constexpr iterator begin() noexcept { return engine_.begin(); }
@@ -146,6 +201,10 @@ class vector {
     constexpr engine_type& engine() noexcept { return engine_; }
     constexpr engine_type const& engine() const noexcept { return engine_; }
 
+    // EXT: direct (strided) access to the storage of engines that have a span_type, see span.h.
+    constexpr auto span() noexcept { return engine_.span(); }
+    constexpr auto span() const noexcept { return engine_.span(); }
+
     //- Modifiers
     //
     constexpr void swap(vector& rhs) noexcept;
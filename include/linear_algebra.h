@@ -15,6 +15,8 @@
 #pragma once
 
 #include "bits/linear_algebra/base.h"
+#include "bits/linear_algebra/span.h"
+#include "bits/linear_algebra/allocator.h"
 
 // operation traits
 #include "bits/linear_algebra/operation_traits.h"
@@ -24,6 +26,7 @@
 #include "bits/linear_algebra/fs_matrix_engine.h"
 #include "bits/linear_algebra/dr_vector_engine.h"
 #include "bits/linear_algebra/dr_matrix_engine.h"
+#include "bits/linear_algebra/csr_matrix_engine.h"
 
 // non-owning engines
 #include "bits/linear_algebra/scalar_engine.h"
@@ -37,10 +40,16 @@
 #include "bits/linear_algebra/matrix.h"
 
 #include "bits/linear_algebra/arithmetic_operators.h"
+#include "bits/linear_algebra/expression.h"
 #include "bits/linear_algebra/convenience_aliases.h"
 
 // stuff that wasn't mentioned in the paper
 #include "bits/linear_algebra/ext.h"
 #include "bits/linear_algebra/ext_permutation.h"
+#include "bits/linear_algebra/ext_lu.h"
 #include "bits/linear_algebra/ext_det.h"
+#include "bits/linear_algebra/ext_blas.h"
+#include "bits/linear_algebra/ext_transform.h"
+#include "bits/linear_algebra/fs_matrix_batch.h"
+#include "bits/linear_algebra/triplet_builder.h"
 
@@ -16,6 +16,8 @@
 #include <linear_algebra>
 #include "support.h"
 
+#include <complex>
+
 #include <catch2/catch.hpp>
 
 TEST_CASE("addition: vector")
@@ -50,3 +52,107 @@ TEST_CASE("addition: fs dr")
     static_assert(std::is_same_v<decltype(r2), decltype(dr)>, "result engine must be dyn_matrix");
     CHECK(r2 == re);
 }
+
+TEST_CASE("addition: in place")
+{
+    SECTION("fs")
+    {
+        auto static CONSTEXPR m = [] {
+            auto m1 = imat<2, 2>{1, 2, 3, 4};
+            m1 += imat<2, 2>{2, 3, 4, 5};
+            return m1;
+        }();
+        REQUIRE(m == imat<2, 2>{3, 5, 7, 9});
+    }
+
+    SECTION("dr")
+    {
+        auto v = dvec<double>(ivec<3>{0, 1, 2});
+        auto const* const data = v.span().data();
+        v += ivec<3>{3, 4, 5};
+        CHECK(v == ivec<3>{3, 5, 7});
+        CHECK(v.span().data() == data);
+
+        // padded, so that the rows are not adjacent
+        auto m = dmat<double>(2, 3, 4, 5);
+        m = imat<2, 3>{1, 2, 3, 4, 5, 6};
+        m += dmat<double>(imat<2, 3>{1, 1, 1, 2, 2, 2});
+        CHECK(m == imat<2, 3>{2, 3, 4, 6, 7, 8});
+    }
+
+    SECTION("views")
+    {
+        auto m = dmat<int>(imat<3, 3>{1, 2, 3,
+                                      4, 5, 6,
+                                      7, 8, 9});
+        m.row(0) += ivec<3>{10, 20, 30};
+        m.column(2) += ivec<3>{100, 100, 100};
+        m.submatrix(0, 1, 2, 1) += imat<2, 2>{1000, 1000, 1000, 1000}; // without row 0 and column 2
+        CHECK(m == imat<3, 3>{  11,   22,  133,
+                              1004, 1005,  106,
+                              1007, 1008,  109});
+
+        m.t() += imat<3, 3>{1, 0, 0,
+                            1, 0, 0,
+                            1, 0, 0};
+        CHECK(m.row(0) == ivec<3>{12, 23, 134});
+    }
+
+    SECTION("aliasing transpose")
+    {
+        auto m = dmat<double>(imat<2, 2>{1, 2,
+                                         3, 4});
+        m += m.t();
+        CHECK(m == imat<2, 2>{2, 5,
+                              5, 8});
+
+        // without SIMD kernels, i.e. updated element by element
+        using complex = std::complex<double>;
+        auto c = dmat<complex>(3, 3, [](auto i, auto j) { return complex(double(i * 3 + j + 1), double(i)); });
+        c.t() += c;
+        CHECK(c == dmat<complex>(3, 3, [](auto i, auto j) { return complex(double(i * 3 + j + j * 3 + i + 2), double(i + j)); }));
+
+        auto d = dmat<double>(imat<2, 2>{1, 2,
+                                         3, 4});
+        CHECK(std::move(d) + d.t() == imat<2, 2>{2, 5,
+                                                  5, 8});
+
+        constexpr auto f = [] {
+            auto f = imat<3, 3>{1, 2, 3,
+                                4, 5, 6,
+                                7, 8, 9};
+            f += f.t();
+            return f;
+        }();
+        static_assert(f == imat<3, 3>{ 2,  6, 10,
+                                       6, 10, 14,
+                                      10, 14, 18});
+    }
+}
+
+TEST_CASE("addition: rvalue operands")
+{
+    auto const b = dmat<double>(3, 2, [](auto i, auto j) { return static_cast<double>(i * 10 + j); });
+    auto const c = dmat<double>(3, 2, [](auto, auto) { return 1.0; });
+    auto const expected = dmat<double>(3, 2, [](auto i, auto j) { return static_cast<double>(2 * (i * 10 + j) + 1); });
+
+    auto a = b;
+    auto const* const data = a.span().data();
+    auto const r1 = std::move(a) + b + c;
+    CHECK(r1 == expected);
+    CHECK(r1.span().data() == data);
+
+    auto d = b;
+    auto const* const data2 = d.span().data();
+    auto const r2 = c + (b + std::move(d));
+    CHECK(r2 == expected);
+    CHECK(r2.span().data() == data2);
+
+    // result of a different type than the expiring operand, i.e. not reused
+    auto const r3 = b + dmat<int>(imat<3, 2>{1, 1, 1, 1, 1, 1});
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(r3)>, dmat<double>>);
+    CHECK(r3 == b + c);
+
+    auto v = dvec<double>(ivec<3>{0, 1, 2});
+    CHECK(std::move(v) + ivec<3>{3, 4, 5} == ivec<3>{3, 5, 7});
+}
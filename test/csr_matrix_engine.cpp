@@ -0,0 +1,197 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <catch2/catch.hpp>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+namespace execution = la::execution;
+
+template <typename T>
+using csr_mat = la::csr_matrix<T>;
+
+TEST_CASE("csr_matrix_engine.create")
+{
+    auto static CONSTEXPR m = imat<3, 4>{1, 0, 2, 0,
+                                         0, 0, 0, 0,
+                                         0, 3, 0, 4};
+    SECTION("from dense") {
+        csr_mat<int> const s = m;
+        CHECK(s == m);
+        CHECK(s.rows() == 3);
+        CHECK(s.columns() == 4);
+        CHECK(s.engine().nonzeros() == 4);
+        CHECK(s.engine().row_offsets() == std::vector<std::size_t>{0, 2, 2, 4});
+        CHECK(s.engine().column_indices() == std::vector<std::size_t>{0, 2, 1, 3});
+        CHECK(s.engine().values() == std::vector<int>{1, 2, 3, 4});
+    }
+
+    SECTION("from arrays") {
+        auto const s = csr_mat<int>(la::csr_matrix_engine<int>(3, 4, {0, 2, 2, 4}, {0, 2, 1, 3}, {1, 2, 3, 4}));
+        CHECK(s == m);
+    }
+
+    SECTION("element assignment") {
+        auto s = csr_mat<int>(3, 4);
+        s(2, 3) = 4;
+        s(0, 2) = 2;
+        s(2, 1) = 3;
+        s(0, 0) = 1;
+        s(1, 1) = 0; // zeros are not stored
+        CHECK(s == m);
+        CHECK(s.engine().nonzeros() == 4);
+
+        s(0, 2) = 7; // updates in-place
+        CHECK(s(0, 2) == 7);
+        CHECK(s.engine().nonzeros() == 4);
+    }
+
+    SECTION("resize") {
+        csr_mat<int> s = m;
+        s.resize(2, 3);
+        CHECK(s == imat<2, 3>{1, 0, 2,
+                              0, 0, 0});
+        CHECK(s.engine().nonzeros() == 2);
+        s.resize(3, 3);
+        CHECK(s(2, 1) == 0);
+    }
+}
+
+TEST_CASE("csr_matrix_engine.swap")
+{
+    auto static CONSTEXPR m = imat<4, 3>{1, 0, 2,
+                                         0, 5, 0,
+                                         6, 7, 8,
+                                         0, 0, 9};
+    csr_mat<int> s = m;
+
+    SECTION("rows") {
+        s.swap_rows(0, 2);
+        CHECK(s == imat<4, 3>{6, 7, 8,
+                              0, 5, 0,
+                              1, 0, 2,
+                              0, 0, 9});
+        s.swap_rows(3, 1);
+        CHECK(s == imat<4, 3>{6, 7, 8,
+                              0, 0, 9,
+                              1, 0, 2,
+                              0, 5, 0});
+    }
+
+    SECTION("columns") {
+        s.swap_columns(0, 2);
+        CHECK(s == imat<4, 3>{2, 0, 1,
+                              0, 5, 0,
+                              8, 7, 6,
+                              9, 0, 0});
+    }
+}
+
+TEST_CASE("csr_matrix_engine.mul")
+{
+    // tridiagonal matrix
+    auto const n = std::size_t{2'000};
+    auto a = csr_mat<double>(n, n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (i > 0)
+            a(i, i - 1) = -1.0;
+        a(i, i) = 2.0;
+        if (i + 1 < n)
+            a(i, i + 1) = -1.0;
+    }
+    REQUIRE(a.engine().nonzeros() == 3 * n - 2);
+
+    auto x = dvec<double>(n);
+    for (std::size_t i = 0; i < n; ++i)
+        x(i) = double(i);
+    auto const y = a * x;
+    static_assert(std::is_same_v<decltype(y), dvec<double> const>);
+
+    // interior rows vanish for a linear x
+    CHECK(y(0) == -1.0);
+    CHECK(y(n / 2) == 0.0);
+    CHECK(y(n - 1) == double(n));
+
+    CHECK(la::multiply(execution::par, a, x) == y);
+
+    SECTION("dense comparison") {
+        auto static CONSTEXPR m = imat<3, 4>{1, 0, 2, 0,
+                                             0, 0, 0, 0,
+                                             0, 3, 0, 4};
+        csr_mat<int> const s = m;
+        auto const v = vec<int, 4>{1, 2, 3, 4};
+        CHECK(s * v == dvec<int>(m * v));
+    }
+}
+
+TEST_CASE("csr_matrix_engine.triplet_builder")
+{
+    auto static CONSTEXPR m = imat<3, 4>{1, 0, 2, 0,
+                                         0, 0, 0, 0,
+                                         0, 3, 0, 4};
+
+    auto builder = la::triplet_builder<int>(3, 4);
+    builder.add(2, 3, 4);
+    builder.add(0, 2, 1);
+    builder.add(2, 1, 3);
+    builder.add(0, 0, 1);
+    builder.add(0, 2, 1); // duplicates are summed up
+    REQUIRE(builder.size() == 5);
+
+    SECTION("csr") {
+        auto const s = csr_mat<int>(builder.build_csr());
+        CHECK(s == m);
+        CHECK(s.engine().nonzeros() == 4);
+        CHECK(s.engine().column_indices() == std::vector<std::size_t>{0, 2, 1, 3});
+    }
+
+    SECTION("csc") {
+        auto const s = csr_mat<int>(builder.build_csc());
+        CHECK(s.rows() == 4);
+        CHECK(s.engine().row_offsets() == std::vector<std::size_t>{0, 1, 2, 3, 4});
+        CHECK(s.engine().column_indices() == std::vector<std::size_t>{0, 2, 0, 2});
+        CHECK(s.t() == m);
+    }
+}
+
+TEST_CASE("csr_matrix_engine.triplet_builder.assemble")
+{
+    // 1D finite-element stiffness matrix: element k couples nodes k and k + 1
+    auto const elements = std::size_t{20'000};
+    auto const assemble = [&](auto policy) {
+        auto builder = la::triplet_builder<double>(elements + 1, elements + 1);
+        builder.assemble(policy, elements, [](auto& buffer, std::size_t k) {
+            buffer.add(k, k, 1.0);
+            buffer.add(k, k + 1, -1.0);
+            buffer.add(k + 1, k, -1.0);
+            buffer.add(k + 1, k + 1, 1.0);
+        });
+        return csr_mat<double>(builder.build_csr());
+    };
+
+    auto const a = assemble(execution::seq);
+    CHECK(a.engine().nonzeros() == 3 * elements + 1);
+    CHECK(a(0, 0) == 1.0);
+    CHECK(a(1, 1) == 2.0);
+    CHECK(a(1, 0) == -1.0);
+    CHECK(a(elements, elements) == 1.0);
+
+    auto const b = assemble(execution::par);
+    CHECK(b.engine().row_offsets() == a.engine().row_offsets());
+    CHECK(b.engine().column_indices() == a.engine().column_indices());
+    CHECK(b.engine().values() == a.engine().values());
+}
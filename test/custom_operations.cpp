@@ -56,6 +56,105 @@ TEST_CASE("custom.engine_promotion")
     CHECK(sum == me);
 }
 
+// custom arithmetics, counting the in-place additions
+struct counting_operation_traits : public la::matrix_operation_traits
+{
+    static inline int additions = 0;
+
+    template <class OTR, class OP1, class OP2>
+    struct addition_assignment_traits
+    {
+        static OP1& add_assign(OP1& op1, OP2 const& op2)
+        {
+            ++additions;
+            return la::matrix_addition_assignment_traits<OTR, OP1, OP2>::add_assign(op1, op2);
+        }
+    };
+};
+
+TEST_CASE("custom.addition_assignment")
+{
+    auto m1 = la::matrix<la::dr_matrix_engine<int>, counting_operation_traits>(imat<2, 2>{1, 2, 3, 4});
+    auto const m2 = dmat<int>(imat<2, 2>{1, 1, 1, 1});
+
+    m1 += m2;
+    m1.row(0) += m2.row(1); // views of m1 keep its operation traits
+
+    CHECK(counting_operation_traits::additions == 2);
+    CHECK(m1 == imat<2, 2>{3, 4, 4, 5});
+}
+
+// custom arithmetics, counting the operations, which must not be bypassed for expiring operands
+struct counting_arithmetic_traits : public la::matrix_operation_traits
+{
+    static inline int operations = 0;
+
+    template <class OTR, class OP1>
+    struct negation_traits
+    {
+        template <class... Args>
+        static auto negate(Args const&... args)
+        {
+            ++operations;
+            return la::matrix_negation_traits<OTR, OP1>::negate(args...);
+        }
+    };
+
+    template <class OTR, class OP1, class OP2>
+    struct addition_traits
+    {
+        template <class... Args>
+        static auto add(Args const&... args)
+        {
+            ++operations;
+            return la::matrix_addition_traits<OTR, OP1, OP2>::add(args...);
+        }
+    };
+
+    template <class OTR, class OP1, class OP2>
+    struct subtraction_traits
+    {
+        template <class... Args>
+        static auto subtract(Args const&... args)
+        {
+            ++operations;
+            return la::matrix_subtraction_traits<OTR, OP1, OP2>::subtract(args...);
+        }
+    };
+
+    template <class OTR, class OP1, class OP2>
+    struct multiplication_traits
+    {
+        template <class... Args>
+        static auto multiply(Args const&... args)
+        {
+            ++operations;
+            return la::matrix_multiplication_traits<OTR, OP1, OP2>::multiply(args...);
+        }
+    };
+};
+
+TEST_CASE("custom.arithmetic.expiring_operands")
+{
+    using counted_mat = la::matrix<la::dr_matrix_engine<int>, counting_arithmetic_traits>;
+    using counted_vec = la::vector<la::dr_vector_engine<int>, counting_arithmetic_traits>;
+    auto const a = counted_mat(imat<2, 2>{1, 2, 3, 4});
+    auto const b = counted_mat(imat<2, 2>{1, 1, 1, 1});
+    auto const x = counted_vec(ivec<2>{1, 2});
+
+    counting_arithmetic_traits::operations = 0;
+    CHECK(counted_mat(a) + b == imat<2, 2>{2, 3, 4, 5});
+    CHECK(a + counted_mat(b) == imat<2, 2>{2, 3, 4, 5});
+    CHECK(counted_mat(a) - b == imat<2, 2>{0, 1, 2, 3});
+    CHECK(a - counted_mat(b) == imat<2, 2>{0, 1, 2, 3});
+    CHECK(-counted_mat(a) == imat<2, 2>{-1, -2, -3, -4});
+    CHECK(counted_mat(a) * 2 == imat<2, 2>{2, 4, 6, 8});
+    CHECK(2 * counted_mat(a) == imat<2, 2>{2, 4, 6, 8});
+    CHECK(counted_vec(x) + x == ivec<2>{2, 4});
+    CHECK(-counted_vec(x) == ivec<2>{-1, -2});
+    CHECK(counting_arithmetic_traits::operations == 9);
+}
+
 // TODO: custom arithmetics (e.g.: trace log printing operations)
 
 // TODO: custom element promotion
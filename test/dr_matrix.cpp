@@ -12,7 +12,10 @@
  * limitations under the License.
  */
 
+#include <cstdint>
 #include <ostream>
+#include <type_traits>
+#include <utility>
 #include <linear_algebra>
 #include "support.h"
 
@@ -35,6 +38,22 @@ TEST_CASE("dr_matrix.ctor")
         auto const m2 = me;
         REQUIRE(m2 == me);
     }
+
+    SECTION("uninitialized")
+    {
+        auto m3 = dmat<int>(math::uninitialized, 3, 4, 5, 8);
+        REQUIRE(m3.rows() == 3);
+        REQUIRE(m3.columns() == 4);
+        REQUIRE(m3.row_capacity() == 5);
+        REQUIRE(m3.column_capacity() == 8);
+        m3 = me;
+        CHECK(m3 == me);
+
+        // value-initialized when not asked otherwise
+        auto const m4 = dmat<int>(3, 4, 5, 8);
+        for (auto [i, j] : math::detail::times(m4.rows()) * math::detail::times(m4.columns()))
+            CHECK(m4(i, j) == 0);
+    }
 }
 
 TEST_CASE("dr_matrix.resize")
@@ -75,6 +94,98 @@ TEST_CASE("dr_matrix.resize")
     }
 }
 
+TEST_CASE("dr_matrix.padded")
+{
+    using math::detail::padded_leading_dimension;
+    CHECK(padded_leading_dimension<double>(3) == 8);
+    CHECK(padded_leading_dimension<double>(8) == 8);
+    CHECK(padded_leading_dimension<double>(64) == 72);   // not 512 bytes
+    CHECK(padded_leading_dimension<double>(100) == 104);
+    CHECK(padded_leading_dimension<float>(1024) == 1040); // not 4 KiB
+    CHECK(padded_leading_dimension<int>(1) == 16);
+
+    using aligned_matrix = math::dyn_matrix<double, math::aligned_allocator<double>>;
+    auto a = aligned_matrix(math::padded, 37, 64);
+    REQUIRE(a.rows() == 37);
+    REQUIRE(a.columns() == 64);
+    REQUIRE(a.column_capacity() == 72);
+    for (auto i : math::detail::times(a.rows()))
+        CHECK(reinterpret_cast<std::uintptr_t>(&a(i, 0)) % math::cache_line_size == 0);
+
+    // padded operands run row by row, and give the same results as dense ones
+    for (auto [i, j] : math::detail::times(a.rows()) * math::detail::times(a.columns()))
+        a(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5.0;
+    auto const d = dmat<double>(a);
+    auto const b = aligned_matrix(a);
+
+    CHECK(a + b == d + d);
+    CHECK(a - d == dmat<double>(37, 64));
+    CHECK(-a == -d);
+    CHECK(a * 2.0 == d * 2.0);
+    CHECK(a * b.t() == d * d.t());
+
+    a += d;
+    a *= 0.5;
+    CHECK(a == d);
+}
+
+TEST_CASE("dr_matrix.column_major")
+{
+    using cmat = math::dyn_matrix<int, std::allocator<int>, math::column_major>;
+    auto const me = imat<3, 4>{0, 1, 2, 3,
+                               4, 5, 6, 7,
+                               8, 9, 10, 11};
+
+    auto m = cmat(me);
+    REQUIRE(m == me);
+    CHECK(m.span().data()[1] == 4); // m(1, 0)
+    CHECK(m.span().data()[3] == 1); // m(0, 1)
+
+    auto const s = std::as_const(m).span();
+    CHECK(s.is_column_major());
+    CHECK(s.row_stride() == 1);
+    CHECK(s.column_stride() == 3);
+
+    SECTION("resize")
+    {
+        m.resize(4, 5);
+        CHECK(m == dmat<int>(imat<4, 5>{0, 1, 2, 3, 0,
+                                        4, 5, 6, 7, 0,
+                                        8, 9, 10, 11, 0,
+                                        0, 0, 0, 0, 0}));
+    }
+
+    SECTION("padded")
+    {
+        using aligned_cmat = math::dyn_matrix<double, math::aligned_allocator<double>, math::column_major>;
+        auto a = aligned_cmat(math::padded, 64, 37);
+        REQUIRE(a.row_capacity() == 72);
+        REQUIRE(a.column_capacity() == 37);
+        for (auto j : math::detail::times(a.columns()))
+            CHECK(reinterpret_cast<std::uintptr_t>(&a(0, j)) % math::cache_line_size == 0);
+    }
+
+    SECTION("mixed layout arithmetic")
+    {
+        auto const d = dmat<int>(me);
+        auto const r = m + d;
+        static_assert(std::is_same_v<std::remove_cv_t<decltype(r)>, cmat>);
+        CHECK(r == d * 2);
+        CHECK(d - m == dmat<int>(3, 4));
+        CHECK(-m == -d);
+    }
+
+    SECTION("transpose by layout")
+    {
+        auto const* data = m.span().data();
+        auto t = math::transpose(std::move(m));
+        static_assert(std::is_same_v<decltype(t), dmat<int>>);
+        CHECK(t.span().data() == data);
+        CHECK(t == me.t());
+        CHECK(math::transpose(std::move(t)) == me);
+    }
+}
+
 TEST_CASE("dr_matrix.row")
 {
     auto const m1 = dmat<int>(imat<3, 4>{1, 2, 3, 4,
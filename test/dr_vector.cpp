@@ -32,6 +32,29 @@ TEST_CASE("dr_vector.ctor")
         auto static const m2 = me;
         REQUIRE(me == m2);
     }
+
+    SECTION("uninitialized")
+    {
+        auto v = dvec<int>(math::uninitialized, 3);
+        REQUIRE(v.size() == 3);
+        v = ivec<3>{0, 1, 2};
+        CHECK(v == dvec<int>{0, 1, 2});
+
+        // value-initialized when not asked otherwise, also when growing
+        v.resize(5);
+        CHECK(v == dvec<int>{0, 1, 2, 0, 0});
+        CHECK(dvec<int>(4) == dvec<int>{0, 0, 0, 0});
+    }
+
+    SECTION("default_init_allocator")
+    {
+        auto v = std::vector<int, math::default_init_allocator<int>>{1, 2, 3};
+        v.resize(5);
+        REQUIRE(v.size() == 5);
+        CHECK(v[2] == 3);
+        v.resize(6, 7);
+        CHECK(v[5] == 7);
+    }
 }
 
 
@@ -0,0 +1,121 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+namespace execution = la::execution;
+using la::detail::times;
+
+TEST_CASE("execution.thread_pool")
+{
+    auto pool = la::detail::thread_pool{4};
+    REQUIRE(pool.size() == 4);
+
+    SECTION("covers range") {
+        auto hits = std::vector<std::atomic<int>>(10'000);
+        pool.parallel_for(hits.size(), 100, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i)
+                ++hits[i];
+        });
+        CHECK(la::detail::all_of(hits, [](auto const& n) { return n == 1; }));
+    }
+
+    SECTION("small range runs on caller") {
+        auto calls = 0;
+        pool.parallel_for(10, 100, [&](std::size_t begin, std::size_t end) {
+            ++calls;
+            CHECK(begin == 0);
+            CHECK(end == 10);
+        });
+        CHECK(calls == 1);
+    }
+
+    SECTION("exception") {
+        auto const f = [&]() {
+            pool.parallel_for(1000, 1, [](std::size_t begin, std::size_t) {
+                if (begin != 0)
+                    throw std::runtime_error("chunk failed");
+            });
+        };
+        CHECK_THROWS_AS(f(), std::runtime_error);
+    }
+}
+
+TEST_CASE("execution.algorithms")
+{
+    auto const r2 = times(3) * times(4);
+    CHECK(r2[0] == std::tuple{0, 0});
+    CHECK(r2[5] == std::tuple{1, 1});
+    CHECK(r2[11] == std::tuple{2, 3});
+
+    auto const id = [](auto i) { return i; };
+    auto const n = std::size_t{100'000};
+    auto const expected = n * (n - 1) / 2;
+    CHECK(la::detail::sum(execution::seq, times(n), std::size_t{0}, id) == expected);
+    CHECK(la::detail::sum(execution::unseq, times(n), std::size_t{0}, id) == expected);
+    CHECK(la::detail::sum(execution::par, times(n), std::size_t{0}, id) == expected);
+    CHECK(la::detail::sum(execution::par, times(n), std::size_t{7}, [](auto i) { return 2 * i; }) == 7 + 2 * expected);
+
+    auto const lessThan = [&](auto k) { return [=](auto i) { return i < k; }; };
+    CHECK(la::detail::all_of(execution::par, times(n), lessThan(n)));
+    CHECK_FALSE(la::detail::all_of(execution::par, times(n), lessThan(n - 1)));
+
+    auto visited = std::vector<int>(3 * 5'000);
+    la::detail::for_each(execution::unseq, times(3) * times(5'000), [&](auto ij) {
+        auto const [i, j] = ij;
+        visited[i * 5'000 + j] += 1;
+    });
+    la::detail::for_each(execution::par, times(3) * times(5'000), [&](auto ij) {
+        auto const [i, j] = ij;
+        visited[i * 5'000 + j] += 1;
+    });
+    CHECK(la::detail::all_of(visited, [](int v) { return v == 2; }));
+}
+
+namespace {
+    struct parallel_operation_traits : public la::matrix_operation_traits
+    {
+        using execution_policy = la::execution::parallel_policy;
+    };
+}
+
+TEST_CASE("execution.operations")
+{
+    auto const a = dmat<long>(130, 170, [](auto i, auto j) { return long(i * 3 + j) % 7 - 3; });
+    auto const b = dmat<long>(130, 170, [](auto i, auto j) { return long(i + 2 * j) % 5 - 2; });
+    auto const bt = dmat<long>(170, 90, [](auto i, auto j) { return long(i * j) % 11 - 5; });
+
+    CHECK(la::add(execution::par, a, b) == a + b);
+    CHECK(la::subtract(execution::unseq, a, b) == a - b);
+    CHECK(la::negate(execution::par, a) == -a);
+    CHECK(la::multiply(execution::par, a, 3L) == a * 3L);
+    CHECK(la::multiply(execution::par, 3L, a) == 3L * a);
+    CHECK(la::multiply(execution::par, a, bt) == a * bt);
+
+    auto const v = dvec<long>{1, 2, 3};
+    CHECK(la::multiply(execution::par, v, v) == 14);
+
+    auto const ap = la::matrix<la::dr_matrix_engine<long>, parallel_operation_traits>(a);
+    static_assert(std::is_same_v<la::execution_policy_t<parallel_operation_traits>, execution::parallel_policy>);
+    static_assert(std::is_same_v<la::execution_policy_t<la::matrix_operation_traits>, execution::sequenced_policy>);
+    CHECK(ap + ap == a + a);
+}
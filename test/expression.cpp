@@ -0,0 +1,113 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <catch2/catch.hpp>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+
+TEST_CASE("expression.matrix")
+{
+    auto static CONSTEXPR a = imat<2, 3>{1, 2, 3,
+                                         4, 5, 6};
+    auto static CONSTEXPR b = imat<2, 3>{1, 1, 1,
+                                         2, 2, 2};
+    auto static CONSTEXPR c = imat<2, 3>{0, 1, 0,
+                                         1, 0, 1};
+
+    SECTION("fs") {
+        auto const e = la::lazy(a) + b - c;
+        static_assert(la::is_matrix_expression_v<decltype(e)>);
+        static_assert(decltype(e)::is_fusable);
+        static_assert(std::is_same_v<decltype(e)::result_type, imat<2, 3>>);
+
+        imat<2, 3> const r = e;
+        CHECK(r == a + b - c);
+        CHECK(e.eval() == a + b - c);
+    }
+
+    SECTION("negation and scalar") {
+        imat<2, 3> const r = -(2 * la::lazy(a)) + b * 3;
+        CHECK(r == -(2 * a) + b * 3);
+    }
+
+    SECTION("dr") {
+        auto const da = dmat<int>(a);
+        auto const db = dmat<int>(b);
+        dmat<int> r = la::lazy(da) + db + da;
+        CHECK(r == da + db + da);
+
+        // re-assigning an expression reuses the target's storage
+        r = la::lazy(da) - db;
+        CHECK(r == da - db);
+    }
+
+    SECTION("views") {
+        imat<3, 2> const r = la::lazy(a.t()) + b.t();
+        CHECK(r == imat<3, 2>{2, 6,
+                              3, 7,
+                              4, 8});
+    }
+}
+
+TEST_CASE("expression.vector")
+{
+    auto const a = dvec<double>{1, 2, 3};
+    auto const b = dvec<double>{4, 5, 6};
+
+    dvec<double> const r = la::lazy(a) + b + b - a;
+    CHECK(r == dvec<double>{8, 10, 12});
+
+    auto const f = vec<double, 3>{1, 2, 3};
+    vec<double, 3> const g = la::lazy(f) * 2.0 + vec<double, 3>{1, 1, 1};
+    CHECK(g == vec<double, 3>{3, 5, 7});
+}
+
+namespace {
+    struct counting_addition_traits_state { static inline int calls = 0; };
+
+    template <class OT, class OP1, class OP2>
+    struct counting_addition_traits : public la::matrix_addition_traits<OT, OP1, OP2>
+    {
+        using base = la::matrix_addition_traits<OT, OP1, OP2>;
+        constexpr static typename base::result_type add(OP1 const& a, OP2 const& b)
+        {
+            ++counting_addition_traits_state::calls;
+            return base::add(a, b);
+        }
+    };
+
+    struct counting_operation_traits : public la::matrix_operation_traits
+    {
+        template <class OTR, class OP1, class OP2>
+        using addition_traits = counting_addition_traits<OTR, OP1, OP2>;
+    };
+}
+
+TEST_CASE("expression.custom_operation_traits")
+{
+    using cmat = la::matrix<la::fs_matrix_engine<int, 2, 2>, counting_operation_traits>;
+    auto const a = cmat{1, 2, 3, 4};
+
+    auto const e = la::lazy(a) + a + a;
+    static_assert(std::is_same_v<decltype(e)::op_traits, counting_operation_traits>);
+    static_assert(!decltype(e)::is_fusable);
+
+    counting_addition_traits_state::calls = 0;
+    cmat const r = e;
+    CHECK(counting_addition_traits_state::calls == 2);
+    CHECK(r == cmat{3, 6, 9, 12});
+}
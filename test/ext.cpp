@@ -14,7 +14,11 @@
 
 #include <linear_algebra>
 #include "support.h"
+#include <cmath>
+#include <limits>
+#include <set>
 #include <sstream>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -43,6 +47,212 @@ TEST_CASE("ext.trace")
     CHECK(la::trace(m1) == 273);
 }
 
+TEST_CASE("ext.transpose")
+{
+    SECTION("fs_matrix")
+    {
+        auto static CONSTEXPR m1 = imat<2, 3>{1, 2, 3,
+                                              4, 5, 6};
+        auto static CONSTEXPR m2 = la::transpose(m1);
+        static_assert(std::is_same_v<std::remove_cv_t<decltype(m2)>, imat<3, 2>>);
+        CHECK(m2 == imat<3, 2>{1, 4,
+                               2, 5,
+                               3, 6});
+    }
+
+    SECTION("expiring fs_matrix")
+    {
+        // reads the storage as is, in the other layout
+        auto static CONSTEXPR m2 = la::transpose(imat<2, 3>{1, 2, 3,
+                                                            4, 5, 6});
+        static_assert(std::is_same_v<std::remove_cv_t<decltype(m2)>, la::fs_matrix<int, 3, 2, la::column_major>>);
+        CHECK(m2 == imat<3, 2>{1, 4,
+                               2, 5,
+                               3, 6});
+    }
+
+    SECTION("dyn_matrix")
+    {
+        // Larger than a few tiles, with dimensions not a multiple of the tile size, and padded.
+        auto m1 = dmat<double>(77, 133, 80, 140);
+        for (auto [i, j] : la::detail::times(m1.rows()) * la::detail::times(m1.columns()))
+            m1(i, j) = static_cast<double>(i * 1000 + j);
+
+        auto const m2 = la::transpose(m1);
+        static_assert(std::is_same_v<std::remove_cv_t<decltype(m2)>, dmat<double>>);
+        REQUIRE(m2.rows() == 133);
+        REQUIRE(m2.columns() == 77);
+        CHECK(m2 == m1.t());
+        CHECK(dmat<double>(m1.t()) == m2);
+
+        // self-assignment of a non-square transpose view
+        m1 = m1.t();
+        CHECK(m1 == m2);
+    }
+}
+
+TEST_CASE("ext.transpose_in_place")
+{
+    SECTION("fs_matrix")
+    {
+        auto m1 = imat<3, 3>{1, 2, 3,
+                             4, 5, 6,
+                             7, 8, 9};
+        la::transpose_in_place(m1);
+        CHECK(m1 == imat<3, 3>{1, 4, 7,
+                               2, 5, 8,
+                               3, 6, 9});
+    }
+
+    SECTION("dyn_matrix")
+    {
+        auto m1 = dmat<double>(101, 101, 101, 104);
+        for (auto [i, j] : la::detail::times(m1.rows()) * la::detail::times(m1.columns()))
+            m1(i, j) = static_cast<double>(i * 1000 + j);
+        auto const expected = la::transpose(m1);
+
+        la::transpose_in_place(m1);
+        CHECK(m1 == expected);
+    }
+}
+
+TEST_CASE("ext.blas.axpy")
+{
+    SECTION("fs_vector")
+    {
+        auto static CONSTEXPR y = [] {
+            auto y = ivec<3>{1, 2, 3};
+            la::axpy(2, ivec<3>{1, 0, -1}, y);
+            return y;
+        }();
+        CHECK(y == ivec<3>{3, 2, 1});
+    }
+
+    SECTION("dyn_vector")
+    {
+        auto x = dvec<double>(1001);
+        auto y = dvec<double>(1001);
+        for (auto i : la::detail::times(x.size()))
+        {
+            x(i) = static_cast<double>(i % 7);
+            y(i) = static_cast<double>(i % 5);
+        }
+        auto const data = y.span().data();
+
+        la::axpy(la::execution::par, 3, x, y);
+        CHECK(y.span().data() == data);
+        for (auto i : la::detail::times(y.size()))
+            CHECK(y(i) == static_cast<double>(3 * (i % 7) + i % 5));
+    }
+
+    SECTION("dyn_matrix")
+    {
+        // padded, i.e. not flat, and a row view as destination
+        auto x = dmat<double>(5, 7, [](auto i, auto j) { return static_cast<double>(i + j); });
+        auto y = dmat<double>(5, 7, 8, 8);
+        la::axpy(2.0, x, y);
+        CHECK(y == 2.0 * x);
+
+        la::axpy(-1.0, x.row(2), y.row(1));
+        for (auto j : la::detail::times(y.columns()))
+            CHECK(y(1, j) == 2.0 * x(1, j) - x(2, j));
+    }
+}
+
+TEST_CASE("ext.blas.gemv")
+{
+    SECTION("fs_matrix")
+    {
+        auto static CONSTEXPR y = [] {
+            auto y = ivec<2>{1, 2};
+            la::gemv(2, imat<2, 3>{1, 2, 3, 4, 5, 6}, ivec<3>{3, 1, 2}, -1, y);
+            return y;
+        }();
+        CHECK(y == ivec<2>{21, 56});
+    }
+
+    SECTION("dyn_matrix")
+    {
+        auto a = dmat<double>(37, 53, 40, 64);
+        for (auto [i, j] : la::detail::times(a.rows()) * la::detail::times(a.columns()))
+            a(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5.0;
+
+        auto x = dvec<double>(53);
+        for (auto j : la::detail::times(x.size()))
+            x(j) = static_cast<double>(j % 5) - 2.0;
+
+        auto y = dvec<double>(37);
+        for (auto i : la::detail::times(y.size()))
+            y(i) = static_cast<double>(i % 3) - 1.0;
+
+        auto const ax = a * x;
+        auto const y0 = y;
+        la::gemv(2.0, a, x, 3.0, y);
+        CHECK(y == 2.0 * ax + 3.0 * y0);
+
+        // beta == 0 must not read y
+        for (auto i : la::detail::times(y.size()))
+            y(i) = std::numeric_limits<double>::quiet_NaN();
+        la::gemv(la::execution::par, 1.0, a, x, 0.0, y);
+        CHECK(y == ax);
+
+        // transposed operand
+        auto z = dvec<double>(53);
+        la::gemv(1.0, a.t(), y0, 0.0, z);
+        CHECK(z == y0 * a);
+    }
+}
+
+TEST_CASE("ext.blas.gemm")
+{
+    SECTION("fs_matrix")
+    {
+        auto static CONSTEXPR c = [] {
+            auto c = imat<2, 2>{1, 0, 0, 1};
+            la::gemm(1, imat<2, 3>{1, 2, 3, 4, 5, 6}, imat<3, 2>{1, 0, 0, 1, 1, 1}, 10, c);
+            return c;
+        }();
+        CHECK(c == imat<2, 2>{14, 5, 10, 21});
+    }
+
+    SECTION("dyn_matrix")
+    {
+        auto a = dmat<double>(41, 29, 48, 32);
+        for (auto [i, j] : la::detail::times(a.rows()) * la::detail::times(a.columns()))
+            a(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5.0;
+        auto b = dmat<double>(29, 53, [](auto i, auto j) { return static_cast<double>((i + 2 * j) % 7) - 3.0; });
+        auto c = dmat<double>(41, 53, [](auto i, auto j) { return static_cast<double>(i % 3 + j % 2); });
+
+        auto const ab = a * b;
+        auto const c0 = c;
+        auto const data = c.span().data();
+
+        la::gemm(2.0, a, b, -1.0, c);
+        CHECK(c.span().data() == data);
+        CHECK(c == 2.0 * ab - c0);
+
+        // beta == 0 must not read C
+        for (auto [i, j] : la::detail::times(c.rows()) * la::detail::times(c.columns()))
+            c(i, j) = std::numeric_limits<double>::quiet_NaN();
+        la::gemm(la::execution::par, 1.0, a, b, 0.0, c);
+        CHECK(c == ab);
+
+        // into a transpose view, i.e. D = (A * B)^T
+        auto d = dmat<double>(53, 41);
+        la::gemm(1.0, a, b, 0.0, d.t());
+        CHECK(d == ab.t());
+    }
+
+    SECTION("dyn_matrix<int>")
+    {
+        auto const a = dmat<int>(3, 4, [](auto i, auto j) { return static_cast<int>(i + j); });
+        auto const b = dmat<int>(4, 2, [](auto i, auto j) { return static_cast<int>(i * j); });
+        auto c = dmat<int>(3, 2, [](auto, auto) { return 1; });
+        la::gemm(1, a, b, 2, c);
+        CHECK(c == a * b + dmat<int>(3, 2, [](auto, auto) { return 2; }));
+    }
+}
+
 TEST_CASE("ext.ostream.matrix")
 {
     auto CONSTEXPR m1 = imat<2, 3>{1, 2, 3,
@@ -98,10 +308,129 @@ TEST_CASE("ext.det")
         auto const d = det(a);
         REQUIRE(d == -30);
     }
+
+    SECTION("dr.5x5") {
+        auto const a = dmat<int>(imat<5, 5>{4, 3, 2, 2, 1,
+                                            0, 1, 0,-2, 1,
+                                            1,-1, 0, 3, 1,
+                                            2, 3, 0, 1, 1,
+                                            1, 1, 1, 1, 1});
+        REQUIRE(det(a) == -30);
+    }
+
+    SECTION("dr.4x4.double") {
+        auto const a = dmat<double>(mat<double, 4, 4>{4, 3, 2, 2,
+                                                      0, 1, 0,-2,
+                                                      1,-1, 0, 3,
+                                                      2, 3, 0, 1});
+        REQUIRE(det(a) == Approx(-10.0));
+    }
+
+    SECTION("fs.12x12.double") {
+        // Tridiagonal (-1, 2, -1) matrix, whose determinant is n + 1.
+        auto const a = mat<double, 12, 12>([](auto i, auto j) {
+            return i == j ? 2.0 : (i == j + 1 || j == i + 1) ? -1.0 : 0.0;
+        });
+        REQUIRE(det(a) == Approx(13.0));
+    }
+
+    SECTION("singular") {
+        auto const a = dmat<double>(mat<double, 4, 4>{1, 2, 3, 4,
+                                                      2, 4, 6, 8,
+                                                      0, 1, 0, 1,
+                                                      1, 0, 1, 0});
+        REQUIRE(det(a) == 0.0);
+        REQUIRE_FALSE(is_invertible(a));
+    }
+}
+
+TEST_CASE("ext.lu")
+{
+    auto const a = dmat<double>(mat<double, 4, 4>{ 2, 1, 1, 0,
+                                                   4, 3, 3, 1,
+                                                   8, 7, 9, 5,
+                                                   6, 7, 9, 8});
+    auto const lu = la::lu_factorization(a);
+    REQUIRE_FALSE(lu.is_singular());
+    CHECK(lu.det() == Approx(det(mat<double, 4, 4>(a))));
+
+    // Reconstruct P * A from the packed L and U factors.
+    auto pa = a;
+    for (auto k : la::detail::times(pa.rows()))
+        pa.swap_rows(k, lu.pivots()[k]);
+
+    auto const& packed = lu.packed();
+    for (auto [i, j] : la::detail::times(a.rows()) * la::detail::times(a.columns()))
+    {
+        double v = 0;
+        for (auto k : la::detail::times(std::min(i, j) + 1))
+            v += (k == i ? 1.0 : packed(i, k)) * packed(k, j);
+        CHECK(v == Approx(pa(i, j)));
+    }
+
+    auto const ai = lu.inverse();
+    auto const id = a * ai;
+    for (auto [i, j] : la::detail::times(a.rows()) * la::detail::times(a.columns()))
+        CHECK(id(i, j) == Approx(i == j ? 1.0 : 0.0).margin(1e-12));
+
+    // only the dynamically-sized factorization allocates (its pivots)
+    static_assert(std::is_nothrow_constructible_v<la::lu_factorization<la::fs_matrix_engine<double, 4, 4>>, mat<double, 4, 4>&&>);
+    static_assert(!std::is_nothrow_constructible_v<la::lu_factorization<la::dr_matrix_engine<double>>, dmat<double>&&>);
+}
+
+TEST_CASE("ext.lu.solve")
+{
+    auto const a = mat<double, 3, 3>{ 2, 1, -1,
+                                     -3, -1, 2,
+                                     -2, 1, 2};
+    auto const lu = la::lu_factorization(a);
+
+    SECTION("vector")
+    {
+        auto const x = lu.solve(vec<double, 3>{8, -11, -3});
+        CHECK(x(0) == Approx(2));
+        CHECK(x(1) == Approx(3));
+        CHECK(x(2) == Approx(-1));
+        CHECK(la::solve(a, vec<double, 3>{8, -11, -3}) == x);
+    }
+
+    SECTION("many right-hand sides")
+    {
+        auto b = dmat<double>(mat<double, 3, 2>{  8, 1,
+                                                -11, -1,
+                                                 -3, 3});
+        auto const x = lu.solve(b);
+        auto const ax = a * x;
+        for (auto [i, j] : la::detail::times(b.rows()) * la::detail::times(b.columns()))
+            CHECK(ax(i, j) == Approx(b(i, j)));
+
+        // Solving in place gives the same result as solving column by column.
+        lu.solve_into(b);
+        for (auto [i, j] : la::detail::times(b.rows()) * la::detail::times(b.columns()))
+            CHECK(b(i, j) == Approx(x(i, j)));
+    }
+
+    SECTION("into column view")
+    {
+        auto b = mat<double, 3, 2>{  1, 8,
+                                    -1, -11,
+                                     3, -3};
+        lu.solve_into(b.column(1));
+        CHECK(b(0, 1) == Approx(2));
+        CHECK(b(1, 1) == Approx(3));
+        CHECK(b(2, 1) == Approx(-1));
+        CHECK(b(0, 0) == 1);
+    }
+
+    SECTION("singular")
+    {
+        auto const s = la::lu_factorization(mat<double, 2, 2>{1, 2, 2, 4});
+        auto b = vec<double, 2>{1, 1};
+        CHECK_THROWS_AS(s.solve_into(b), std::domain_error);
+    }
 }
 
-#if 0
-TEST_CASE("ext.inverse") // TODO
+TEST_CASE("ext.inverse")
 {
     SECTION("1x1") {
         auto CONSTEXPR static m = imat<1, 1>{1};
@@ -127,8 +456,346 @@ TEST_CASE("ext.inverse") // TODO
                                 20, -15, -4,
                                 -5,  4,  1});
     }
+    SECTION("3x3.dr") {
+        auto const m = dmat<int>(imat<3, 3>{1, 2, 3,
+                                            0, 1, 4,
+                                            5, 6, 0});
+        CHECK(la::inverse(m) == dmat<int>(imat<3, 3>{-24,  18,  5,
+                                                      20, -15, -4,
+                                                      -5,  4,  1}));
+    }
+    SECTION("4x4") {
+        auto const m = mat<double, 4, 4>{ 2, 1, 1, 0,
+                                          4, 3, 3, 1,
+                                          8, 7, 9, 5,
+                                          6, 7, 9, 8};
+        auto const expected = la::lu_factorization(m).inverse();
+        auto const mi = la::inverse(m);
+        auto const di = la::inverse(dmat<double>(m));
+        for (auto [i, j] : la::detail::times(4) * la::detail::times(4))
+        {
+            CHECK(mi(i, j) == Approx(expected(i, j)).margin(1e-12));
+            CHECK(di(i, j) == Approx(expected(i, j)).margin(1e-12));
+        }
+    }
+    SECTION("4x4 float") {
+        // SSE kernel at run time, for either layout
+        auto const m = mat<float, 4, 4>{ 2, 1, 1, 0,
+                                         4, 3, 3, 1,
+                                         8, 7, 9, 5,
+                                         6, 7, 9, 8};
+        auto const cm = la::fs_matrix<float, 4, 4, la::column_major>(m);
+        auto const expected = la::lu_factorization(mat<double, 4, 4>(m)).inverse();
+        auto const mi = la::inverse(m);
+        auto const cmi = la::inverse(cm);
+        for (auto [i, j] : la::detail::times(4) * la::detail::times(4))
+        {
+            CHECK(mi(i, j) == Approx(expected(i, j)).margin(1e-5));
+            CHECK(cmi(i, j) == Approx(expected(i, j)).margin(1e-5));
+        }
+        CHECK_THROWS_AS(la::inverse(mat<float, 4, 4>{1, 2, 3, 4, 2, 4, 6, 8, 0, 1, 1, 0, 5, 0, 0, 1}), std::domain_error);
+    }
+    SECTION("in-place and out-param") {
+        auto m = dmat<double>(mat<double, 5, 5>{ 0, 2, 0, 1, 3,
+                                                 1, 0, 4, 0, 2,
+                                                 3, 1, 0, 2, 0,
+                                                 0, 5, 1, 0, 1,
+                                                 2, 0, 3, 1, 0});
+        auto out = dmat<double>{};
+        la::inverse_into(m, out);
+        auto const id = m * out;
+        for (auto [i, j] : la::detail::times(5) * la::detail::times(5))
+            CHECK(id(i, j) == Approx(i == j ? 1.0 : 0.0).margin(1e-12));
+
+        la::invert(m);
+        for (auto [i, j] : la::detail::times(5) * la::detail::times(5))
+            CHECK(m(i, j) == Approx(out(i, j)).margin(1e-12));
+
+        auto f = mat<double, 2, 2>{4, 7, 2, 6};
+        la::invert(f);
+        CHECK(f(0, 0) == Approx(0.6));
+        CHECK(f(0, 1) == Approx(-0.7));
+        CHECK(f(1, 0) == Approx(-0.2));
+        CHECK(f(1, 1) == Approx(0.4));
+    }
+    SECTION("singular") {
+        CHECK_THROWS_AS(la::inverse(mat<double, 3, 3>{1, 2, 3, 2, 4, 6, 0, 1, 1}), std::domain_error);
+        auto m = dmat<int>(imat<2, 2>{1, 2, 2, 4});
+        CHECK_THROWS_AS(la::invert(m), std::domain_error);
+    }
+}
+
+TEST_CASE("ext.batch")
+{
+    // more matrices than lanes, and not a multiple of them either
+    auto constexpr K = std::size_t{37};
+
+    auto const fill = [](auto& batch, int seed) {
+        using batch_type = std::decay_t<decltype(batch)>;
+        for (auto k : la::detail::times(batch.size()))
+            for (auto [i, j] : la::detail::times(batch.rows()) * la::detail::times(batch.columns()))
+                batch(k, i, j) = typename batch_type::value_type(int(k * 5 + i * 7 + j * 3 + seed) % 11 - 5 + (i == j ? 12 : 0));
+    };
+
+    SECTION("layout")
+    {
+        auto b = la::fs_matrix_batch<float, 2, 3>(K);
+        CHECK(b.size() == K);
+        CHECK(b.stride() >= K);
+        CHECK(b.plane(0, 1) == b.plane(0, 0) + b.stride());
+        CHECK(b.plane(1, 0) == b.plane(0, 0) + 3 * b.stride());
+
+        b.set(4, mat<float, 2, 3>{1, 2, 3, 4, 5, 6});
+        CHECK(b.get(4) == mat<float, 2, 3>{1, 2, 3, 4, 5, 6});
+        CHECK(b.get(3) == mat<float, 2, 3>{});
+        CHECK(b.plane(1, 2)[4] == 6);
+        CHECK(b.span(4)(1, 0) == 4);
+
+        auto cb = la::fs_matrix_batch<float, 2, 3, std::allocator<float>, la::column_major>(K);
+        auto const cm = la::fs_matrix<float, 2, 3, la::column_major>{1, 2, 3, 4, 5, 6};
+        cb.set(4, cm);
+        CHECK(cb.get(4) == cm);
+        CHECK(cb.get(4).engine().data()[1] == 4);
+        CHECK(cb.plane(1, 0)[4] == 4);
+    }
+    SECTION("multiply")
+    {
+        auto a = la::fs_matrix_batch<double, 3, 4>(K);
+        auto b = la::fs_matrix_batch<double, 4, 2>(K);
+        fill(a, 1);
+        fill(b, 2);
+        auto const c = la::multiply(a, b);
+        auto const cp = la::multiply(la::execution::par, a, b);
+        for (auto k : la::detail::times(K))
+        {
+            CHECK(c.get(k) == a.get(k) * b.get(k)); // small integers, i.e. exact
+            CHECK(cp.get(k) == c.get(k));
+        }
+    }
+    SECTION("det")
+    {
+        auto a2 = la::fs_matrix_batch<double, 2, 2>(K);
+        auto a3 = la::fs_matrix_batch<double, 3, 3>(K);
+        auto a4 = la::fs_matrix_batch<double, 4, 4>(K);
+        fill(a2, 1);
+        fill(a3, 2);
+        fill(a4, 3);
+        auto const d2 = la::det(a2);
+        auto const d3 = la::det(a3);
+        auto const d4 = la::det(a4);
+        REQUIRE(d4.size() == K);
+        for (auto k : la::detail::times(K))
+        {
+            CHECK(d2[k] == la::det(a2.get(k)));
+            CHECK(d3[k] == la::det(a3.get(k)));
+            CHECK(d4[k] == Approx(la::det(a4.get(k))));
+        }
+    }
+    SECTION("inverse")
+    {
+        auto a3 = la::fs_matrix_batch<float, 3, 3>(K);
+        auto a4 = la::fs_matrix_batch<double, 4, 4>(K);
+        fill(a3, 4);
+        fill(a4, 5);
+        auto const r3 = la::inverse(a3);
+        auto const r4 = la::inverse(la::execution::par, a4);
+        for (auto k : la::detail::times(K))
+        {
+            auto const e3 = la::inverse(a3.get(k));
+            auto const e4 = la::inverse(a4.get(k));
+            for (auto [i, j] : la::detail::times(3) * la::detail::times(3))
+                CHECK(r3(k, i, j) == Approx(e3(i, j)));
+            for (auto [i, j] : la::detail::times(4) * la::detail::times(4))
+                CHECK(r4(k, i, j) == Approx(e4(i, j)));
+        }
+    }
+    SECTION("solve")
+    {
+        auto a = la::fs_matrix_batch<double, 3, 3>(K);
+        auto b = la::fs_matrix_batch<double, 3, 1>(K);
+        fill(a, 6);
+        fill(b, 7);
+        auto const x = la::solve(a, b);
+        for (auto k : la::detail::times(K))
+        {
+            auto const ax = a.get(k) * x.get(k);
+            for (auto i : la::detail::times(3))
+                CHECK(ax(i, 0) == Approx(b(k, i, 0)).margin(1e-12));
+        }
+    }
+    SECTION("singular")
+    {
+        auto a = la::fs_matrix_batch<double, 2, 2>(K);
+        fill(a, 8);
+        a.set(K - 1, mat<double, 2, 2>{1, 2, 2, 4});
+        CHECK_THROWS_AS(la::inverse(a), std::domain_error);
+        CHECK_THROWS_AS(la::solve(a, la::fs_matrix_batch<double, 2, 3>(K)), std::domain_error);
+        CHECK(la::det(a)[K - 1] == 0);
+    }
+    SECTION("into")
+    {
+        // more than one block of determinants, see any_singular_in_batch()
+        auto constexpr n = std::size_t{600};
+        auto a = la::fs_matrix_batch<double, 3, 3>(n);
+        auto b = la::fs_matrix_batch<double, 3, 2>(n);
+        auto c = la::fs_matrix_batch<double, 3, 2>(n);
+        auto x = la::fs_matrix_batch<double, 3, 2>(n);
+        fill(a, 9);
+        fill(b, 10);
+        la::multiply_into(a, b, c);
+        la::solve_into(la::execution::par, a, b, x);
+        auto const a0 = a;
+        auto const r = la::inverse(a);
+        la::inverse_into(a, a); // in place
+        for (auto k : la::detail::times(n))
+        {
+            CHECK(a.get(k) == r.get(k));
+            CHECK(c.get(k) == a0.get(k) * b.get(k));
+            auto const rb = r.get(k) * b.get(k);
+            for (auto [i, j] : la::detail::times(3) * la::detail::times(2))
+                CHECK(x(k, i, j) == Approx(rb(i, j)));
+        }
+
+        a.set(n - 1, mat<double, 3, 3>{1, 2, 3,
+                                       2, 4, 6,
+                                       0, 0, 1});
+        CHECK_THROWS_AS(la::inverse_into(la::execution::par, a, a), std::domain_error);
+    }
+}
+
+TEST_CASE("ext.transform_points")
+{
+    auto constexpr K = std::size_t{37};
+    auto const m = mat<float, 4, 4>{ 0, -1,  0,  2,
+                                     1,  0,  0, -1,
+                                     0,  0,  2,  3,
+                                     0,  0,  1,  4};
+    auto const point = [](std::size_t k) {
+        return vec<float, 3>{float(k % 7) - 3, float(k % 5) - 2, float(k % 3)};
+    };
+    // the projective reference, via the matrix-vector product
+    auto const expected = [&](std::size_t k) {
+        auto const p = point(k);
+        auto const q = m * vec<float, 4>{p(0), p(1), p(2), 1.0f};
+        return vec<float, 3>{q(0) / q(3), q(1) / q(3), q(2) / q(3)};
+    };
+
+    SECTION("AoS")
+    {
+        auto in = std::vector<float>(K * 3);
+        auto out = std::vector<float>(K * 3);
+        for (auto [k, j] : la::detail::times(K) * la::detail::times(std::size_t{3}))
+            in[k * 3 + j] = point(k)(j);
+        la::transform_points(m, la::matrix_span<float const>(in.data(), K, 3, 3), la::matrix_span<float>(out.data(), K, 3, 3));
+        for (auto [k, i] : la::detail::times(K) * la::detail::times(std::size_t{3}))
+            CHECK(out[k * 3 + i] == Approx(expected(k)(i)));
+    }
+    SECTION("SoA, in place")
+    {
+        auto xyz = std::vector<float>(3 * K);
+        for (auto [k, j] : la::detail::times(K) * la::detail::times(std::size_t{3}))
+            xyz[j * K + k] = point(k)(j);
+        auto const s = la::matrix_span<float>(xyz.data(), K, 3, 1, K);
+        la::transform_points(la::execution::par, m, s, s);
+        for (auto [k, i] : la::detail::times(K) * la::detail::times(std::size_t{3}))
+            CHECK(s(k, i) == Approx(expected(k)(i)));
+    }
+    SECTION("strided")
+    {
+        // every other point
+        auto in = std::vector<float>(K * 8);
+        auto out = std::vector<float>(K * 8);
+        for (auto [k, j] : la::detail::times(K) * la::detail::times(std::size_t{3}))
+            in[k * 8 + j] = point(k)(j);
+        la::transform_points(m, la::matrix_span<float>(in.data(), K, 3, 8), la::matrix_span<float>(out.data(), K, 3, 8));
+        for (auto [k, i] : la::detail::times(K) * la::detail::times(std::size_t{3}))
+            CHECK(out[k * 8 + i] == Approx(expected(k)(i)));
+    }
+    SECTION("homogeneous vectors")
+    {
+        auto in = std::vector<vec<float, 4>>(K);
+        auto out = std::vector<vec<float, 4>>{};
+        for (auto k : la::detail::times(K))
+            in[k] = vec<float, 4>{point(k)(0), point(k)(1), point(k)(2), float(k % 2 + 1)};
+        la::transform_points(m, in, out);
+        REQUIRE(out.size() == K);
+        for (auto k : la::detail::times(K))
+            CHECK(out[k] == m * in[k]);
+    }
+    SECTION("affine")
+    {
+        // the last row of m is ignored, i.e. taken as (0, 0, 0, 1)
+        auto in = std::vector<vec<float, 3>>(K);
+        auto out = std::vector<vec<float, 3>>{};
+        for (auto k : la::detail::times(K))
+            in[k] = point(k);
+        la::transform_points(m, in, out, la::affine);
+        for (auto k : la::detail::times(K))
+        {
+            auto const q = m * vec<float, 4>{in[k](0), in[k](1), in[k](2), 1.0f};
+            CHECK(out[k] == vec<float, 3>{q(0), q(1), q(2)});
+        }
+
+        auto in4 = std::vector<vec<float, 4>>{{1, 2, 3, 0}, {1, 2, 3, 1}};
+        auto out4 = std::vector<vec<float, 4>>{};
+        la::transform_points(m, in4, out4, la::affine);
+        CHECK(out4[0] == vec<float, 4>{-2, 1, 6, 0});
+        CHECK(out4[1] == vec<float, 4>{0, 0, 9, 1});
+    }
+}
+
+TEST_CASE("ext.transform_inverse")
+{
+    auto const check_inverse = [](auto const& m, auto const& mi) {
+        auto const id = m * mi;
+        for (auto [i, j] : la::detail::times(m.rows()) * la::detail::times(m.columns()))
+            CHECK(id(i, j) == Approx(i == j ? 1.0 : 0.0).margin(1e-12));
+    };
+
+    SECTION("affine")
+    {
+        auto CONSTEXPR static m2 = mat<double, 3, 3>{2, 1, 5,
+                                                     1, 1, -3,
+                                                     0, 0, 1};
+        auto CONSTEXPR m2i = la::inverse_affine(m2);
+        CHECK(m2i == mat<double, 3, 3>{1, -1, -8,
+                                       -1, 2, 11,
+                                       0, 0, 1});
+
+        auto const m3 = mat<double, 4, 4>{2, 1, 1, 4,
+                                          4, 3, 3, -1,
+                                          8, 7, 9, 2,
+                                          0, 0, 0, 1};
+        check_inverse(m3, la::inverse_affine(m3));
+        check_inverse(la::fs_matrix<double, 4, 4, la::column_major>(m3),
+                      la::inverse_affine(la::fs_matrix<double, 4, 4, la::column_major>(m3)));
+    }
+    SECTION("rigid")
+    {
+        // rotation about the axis (1, 1, 1) by 120 degrees, i.e. x -> y -> z -> x, and a translation
+        auto CONSTEXPR static m = mat<double, 4, 4>{0, 0, 1, 2,
+                                                    1, 0, 0, -1,
+                                                    0, 1, 0, 3,
+                                                    0, 0, 0, 1};
+        auto CONSTEXPR mi = la::inverse_rigid(m);
+        CHECK(mi == mat<double, 4, 4>{0, 1, 0, 1,
+                                      0, 0, 1, -3,
+                                      1, 0, 0, -2,
+                                      0, 0, 0, 1});
+        CHECK(mi == la::inverse_affine(m));
+
+        auto const c = std::cos(0.3);
+        auto const s = std::sin(0.3);
+        auto const r = mat<double, 3, 3>{c, -s, 0.5,
+                                         s,  c, -2.0,
+                                         0.0, 0.0, 1.0};
+        check_inverse(r, la::inverse_rigid(r));
+    }
+    SECTION("singular")
+    {
+        CHECK_THROWS_AS(la::inverse_affine(mat<double, 4, 4>{1, 2, 3, 1, 2, 4, 6, 1, 0, 1, 1, 1, 0, 0, 0, 1}), std::domain_error);
+    }
 }
-#endif
 
 TEST_CASE("ext.permutation.identity")
 {
@@ -148,11 +815,33 @@ TEST_CASE("ext.permutation.transpositions")
 
 TEST_CASE("ext.permutation.all")
 {
-    auto const pa = la::permutation<3>::all();
+    auto CONSTEXPR pa = la::permutation<3>::all();
     REQUIRE(pa.size() == 6);
-    for (auto const& p : pa)
-        std::cout << "p: " << raw_form(p) << '\n';
-    // TODO: validate all
+    REQUIRE(std::distance(pa.begin(), pa.end()) == 6);
+    CHECK(*pa.begin() == la::permutation<3>::identity());
+
+    SECTION("distinct, with alternating signs")
+    {
+        auto seen = std::set<std::string>{};
+        for (auto i = la::permutation<5>::all().begin(), e = la::permutation<5>::all().end(); i != e; ++i)
+        {
+            CHECK(i.sign() == la::sgn(*i));
+            seen.insert(raw_form(*i));
+        }
+        CHECK(seen.size() == 120);
+    }
+
+    SECTION("constexpr")
+    {
+        // sum of the signs, i.e. as many even as odd permutations
+        auto constexpr signs = []() {
+            int sum = 0;
+            for (auto i = la::permutation<4>::all().begin(); i != la::permutation<4>::all().end(); ++i)
+                sum += i.sign();
+            return sum;
+        }();
+        static_assert(signs == 0);
+    }
 }
 
 TEST_CASE("ext.permutation.composition")
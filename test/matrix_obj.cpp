@@ -39,6 +39,20 @@ TEST_CASE("matrix.ctor")
         auto static CONSTEXPR copy = me;
         REQUIRE(copy == me);
     }
+
+    SECTION("uninitialized")
+    {
+        auto static CONSTEXPR m1 = [] {
+            auto m = imat<3, 4>(la::uninitialized);
+            for (auto [i, j] : la::detail::times(m.rows()) * la::detail::times(m.columns()))
+                m(i, j) = static_cast<int>(i * 4 + j);
+            return m;
+        }();
+        REQUIRE(m1 == me);
+
+        auto static CONSTEXPR zero = imat<3, 4>();
+        CHECK(zero == imat<3, 4>([](auto, auto) { return 0; }));
+    }
 }
 
 TEST_CASE("matrix.row")
@@ -18,6 +18,8 @@
 
 #include <catch2/catch.hpp>
 
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+
 TEST_CASE("multiplication: vector * vector")
 {
     auto static CONSTEXPR v1 = ivec<3>{5, 2, 3};
@@ -63,6 +65,47 @@ TEST_CASE("multiplication: matrix * scalar")
     REQUIRE(m2 == expected);
 }
 
+TEST_CASE("multiplication: in place by scalar")
+{
+    auto static CONSTEXPR m = [] {
+        auto m1 = imat<2, 3>{1, 2, 3, 4, 5, 6};
+        m1 *= 2;
+        m1 /= 3;
+        return m1;
+    }();
+    REQUIRE(m == imat<2, 3>{0, 1, 2, 2, 3, 4});
+
+    auto v = dvec<double>(ivec<3>{1, 2, 3});
+    v *= 4.0;
+    CHECK(v == ivec<3>{4, 8, 12});
+    v /= 2.0;
+    CHECK(v == ivec<3>{2, 4, 6});
+    v *= 0.5f; // element-wise fallback for other scalar types
+    CHECK(v == ivec<3>{1, 2, 3});
+
+    auto d = dmat<double>(3, 17, 4, 20);
+    for (auto [i, j] : la::detail::times(d.rows()) * la::detail::times(d.columns()))
+        d(i, j) = static_cast<double>(i * 100 + j);
+    d *= 3.0;
+    d.column(0) /= 3.0;
+    for (auto [i, j] : la::detail::times(d.rows()) * la::detail::times(d.columns()))
+        REQUIRE(d(i, j) == static_cast<double>(i * 100 + j) * (j == 0 ? 1.0 : 3.0));
+}
+
+TEST_CASE("multiplication: rvalue operand by scalar")
+{
+    auto m = dmat<double>(imat<2, 2>{1, 2, 3, 4});
+    auto const* const data = m.span().data();
+    auto const r = 0.5 * (std::move(m) * 4.0);
+    CHECK(r == imat<2, 2>{2, 4, 6, 8});
+    CHECK(r.span().data() == data);
+
+    // promoted element type, i.e. not reused
+    auto const r2 = dvec<int>(ivec<2>{1, 2}) * 0.5;
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(r2)>, dvec<double>>);
+    CHECK(r2(1) == 1.0);
+}
+
 TEST_CASE("multiplication: matrix * vector")
 {
     auto static CONSTEXPR m = imat<2, 3>{1, 2, 3,
@@ -86,7 +129,65 @@ TEST_CASE("multiplication: matrix * matrix")
     REQUIRE(m3 == me);
 }
 
-// TODO: vector * matrix (where left hand side is treated as transposed vector, i.e. 1-row matrix)
+TEST_CASE("multiplication: vector * matrix")
+{
+    // left hand side is treated as transposed vector, i.e. 1-row matrix
+    auto static CONSTEXPR v = ivec<2>{3, 1};
+    auto static CONSTEXPR m = imat<2, 3>{1, 2, 3,
+                                         4, 5, 6};
+    auto static CONSTEXPR b = v * m;
+    auto static CONSTEXPR expected = ivec<3>{7, 11, 15};
+    REQUIRE(b == expected);
+}
+
+TEST_CASE("multiplication: dr matrix * vector")
+{
+    // Dimensions are chosen to not be a multiple of any SIMD width, and the matrix is padded.
+    auto a = dmat<double>(37, 53, 40, 64);
+    for (auto [i, j] : la::detail::times(a.rows()) * la::detail::times(a.columns()))
+        a(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5.0;
+
+    auto x = dvec<double>(53);
+    for (auto j : la::detail::times(x.size()))
+        x(j) = static_cast<double>(j % 5) - 2.0;
+
+    auto y = dvec<double>(37);
+    for (auto i : la::detail::times(y.size()))
+        y(i) = static_cast<double>(i % 3) - 1.0;
+
+    auto const ax = a * x;
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(ax)>, dvec<double>>);
+    REQUIRE(ax.size() == a.rows());
+    for (auto i : la::detail::times(a.rows()))
+    {
+        double expected = 0;
+        for (auto j : la::detail::times(a.columns()))
+            expected += a(i, j) * x(j);
+        CHECK(ax(i) == expected);
+    }
+    CHECK(la::multiply(la::execution::par, a, x) == ax);
+
+    auto const ya = y * a;
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(ya)>, dvec<double>>);
+    REQUIRE(ya.size() == a.columns());
+    for (auto j : la::detail::times(a.columns()))
+    {
+        double expected = 0;
+        for (auto i : la::detail::times(a.rows()))
+            expected += y(i) * a(i, j);
+        CHECK(ya(j) == expected);
+    }
+    CHECK(la::multiply(la::execution::par, y, a) == ya);
+    CHECK(a.t() * y == ya);
+
+    // mixed fixed-size and dynamically-resizable operands
+    auto const m = imat<2, 3>{1, 2, 3,
+                              4, 5, 6};
+    CHECK(dmat<int>(m) * ivec<3>{3, 1, 2} == ivec<2>{11, 29});
+    CHECK(m * dvec<int>(ivec<3>{3, 1, 2}) == ivec<2>{11, 29});
+    CHECK(ivec<2>{3, 1} * dmat<int>(m) == ivec<3>{7, 11, 15});
+    CHECK(dvec<int>(ivec<2>{3, 1}) * m == ivec<3>{7, 11, 15});
+}
 
 TEST_CASE("multiplication: fs * transpose(fs)")
 {
@@ -124,3 +225,190 @@ TEST_CASE("multiplication: transpose(fs) * transpose(fs)")
     static_assert(std::is_same_v<decltype(r1), decltype(me)>);
 
 }
+
+TEST_CASE("multiplication: dr * dr")
+{
+    // Dimensions are chosen to not be a multiple of any of the GEMM kernel's block sizes.
+    auto const a = dmat<long>(131, 301, [](auto i, auto j) { return static_cast<long>((i * 7 + j * 3) % 11) - 5; });
+    auto const b = dmat<long>(301, 67, [](auto i, auto j) { return static_cast<long>((i * 5 + j * 13) % 9) - 4; });
+
+    auto const c = a * b;
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(c)>, dmat<long>>);
+    REQUIRE(c.rows() == 131);
+    REQUIRE(c.columns() == 67);
+
+    for (auto [i, j] : la::detail::times(c.rows()) * la::detail::times(c.columns()))
+    {
+        long expected = 0;
+        for (auto k : la::detail::times(a.columns()))
+            expected += a(i, k) * b(k, j);
+        REQUIRE(c(i, j) == expected);
+    }
+}
+
+TEST_CASE("multiplication: transposed dr operands")
+{
+    auto const x = dmat<double>(203, 37, [](auto i, auto j) { return static_cast<double>((i * 7 + j * 3) % 11) - 5.0; });
+    auto const y = dmat<double>(37, 203, [](auto i, auto j) { return static_cast<double>((i * 5 + j * 13) % 9) - 4.0; });
+
+    auto const check = [](auto const& a, auto const& b, auto const& c) {
+        static_assert(std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(c)>>, dmat<double>>);
+        REQUIRE(c.rows() == a.rows());
+        REQUIRE(c.columns() == b.columns());
+        for (auto [i, j] : la::detail::times(c.rows()) * la::detail::times(c.columns()))
+        {
+            double expected = 0;
+            for (auto k : la::detail::times(a.columns()))
+                expected += a(i, k) * b(k, j);
+            REQUIRE(c(i, j) == expected);
+        }
+    };
+
+    check(x.t(), x, x.t() * x); // TN, Gram matrix
+    check(x, y.t(), x * y.t()); // NT
+    check(y.t(), x.t(), y.t() * x.t()); // TT
+    CHECK(la::multiply(la::execution::par, x.t(), x) == x.t() * x);
+}
+
+TEST_CASE("multiplication: transposed fs operands")
+{
+    auto static CONSTEXPR m1 = imat<3, 2>{1, 2,
+                                          2, 3,
+                                          3, 4};
+    auto static CONSTEXPR m2 = imat<3, 4>{1, 2, 3, 4,
+                                          2, 3, 4, 5,
+                                          3, 4, 5, 6};
+    auto static CONSTEXPR m3 = m1.t() * m2;
+    auto static CONSTEXPR me = imat<2, 4>{14, 20, 26, 32,
+                                          20, 29, 38, 47};
+    REQUIRE(m3 == me);
+
+    // large enough for the GEMM kernel
+    auto a = mat<double, 24, 20>{};
+    for (auto [i, j] : la::detail::times(a.rows()) * la::detail::times(a.columns()))
+        a(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5.0;
+    auto const g = a.t() * a;
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(g)>, mat<double, 20, 20>>);
+    CHECK(g == dmat<double>(a).t() * dmat<double>(a));
+    for (auto [i, j] : la::detail::times(g.rows()) * la::detail::times(g.columns()))
+    {
+        double expected = 0;
+        for (auto k : la::detail::times(a.rows()))
+            expected += a(k, i) * a(k, j);
+        REQUIRE(g(i, j) == expected);
+    }
+}
+
+TEST_CASE("multiplication: fs * dr")
+{
+    auto const f1 = imat<2, 3>{1, 2, 3,
+                               2, 3, 4};
+    auto const d2 = dmat<int>(imat<3, 4>{1, 2, 3, 4,
+                                         2, 3, 4, 5,
+                                         3, 4, 5, 6});
+    auto const me = imat<2, 4>{14, 20, 26, 32,
+                               20, 29, 38, 47};
+
+    auto const r1 = f1 * d2;
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(r1)>, dmat<int>>);
+    CHECK(r1 == me);
+
+    auto const r2 = dmat<int>(f1) * imat<3, 4>(d2);
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(r2)>, dmat<int>>);
+    CHECK(r2 == me);
+}
+
+TEST_CASE("multiplication: mixed layouts")
+{
+    using cmat = la::dyn_matrix<double, std::allocator<double>, la::column_major>;
+
+    // large enough for the GEMM kernel, which reads either layout through the strides
+    auto const a = dmat<double>(67, 131, [](auto i, auto j) { return static_cast<double>((i * 7 + j * 3) % 11) - 5.0; });
+    auto const b = dmat<double>(131, 45, [](auto i, auto j) { return static_cast<double>((i * 5 + j * 13) % 9) - 4.0; });
+    auto const ab = a * b;
+
+    auto const ca = cmat(a);
+    auto const cb = cmat(b);
+
+    auto const r1 = ca * b;
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(r1)>, cmat>);
+    CHECK(r1 == ab);
+    CHECK(a * cb == ab);
+    CHECK(ca * cb == ab);
+    CHECK(ca * dvec<double>(b.column(0)) == a * dvec<double>(b.column(0)));
+
+    auto static CONSTEXPR m1 = la::fs_matrix<int, 2, 3, la::column_major>{1, 2, 3,
+                                                                          2, 3, 4};
+    auto static CONSTEXPR m2 = imat<3, 4>{1, 2, 3, 4,
+                                          2, 3, 4, 5,
+                                          3, 4, 5, 6};
+    auto static CONSTEXPR m3 = m1 * m2;
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(m3)>, la::fs_matrix<int, 2, 4, la::column_major>>);
+    CHECK(m3 == imat<2, 4>{14, 20, 26, 32,
+                           20, 29, 38, 47});
+}
+
+namespace {
+    template <typename T, std::size_t R, std::size_t K, std::size_t C>
+    void check_unrolled()
+    {
+        auto a = mat<T, R, K>{};
+        for (auto [i, j] : la::detail::times(R) * la::detail::times(K))
+            a(i, j) = static_cast<T>((i * 7 + j * 3) % 11) - T(5);
+        auto b = mat<T, K, C>{};
+        for (auto [i, j] : la::detail::times(K) * la::detail::times(C))
+            b(i, j) = static_cast<T>((i * 5 + j * 13) % 9) - T(4);
+        auto x = vec<T, K>{};
+        for (auto i : la::detail::times(K))
+            x(i) = static_cast<T>(i) - T(2);
+
+        // against the generic loops of the dynamically sized engines
+        auto const da = dmat<T>(a);
+        auto const db = dmat<T>(b);
+        CHECK(a * b == da * db);
+        CHECK(a.t() * a == da.t() * da);
+        CHECK(b * b.t() == db * db.t());
+        CHECK(a * x == da * dvec<T>(x));
+        CHECK(x * b == dvec<T>(x) * db);
+        CHECK(a + a == da + da);
+        CHECK(a - a.t().t() == dmat<T>(R, K));
+    }
+}
+
+TEST_CASE("multiplication: unrolled fs sizes")
+{
+    check_unrolled<int, 2, 2, 2>();
+    check_unrolled<int, 3, 3, 3>();
+    check_unrolled<double, 3, 3, 3>();
+    check_unrolled<double, 4, 4, 4>();
+    check_unrolled<double, 2, 3, 4>();
+    check_unrolled<double, 5, 6, 7>();
+    check_unrolled<long, 8, 8, 8>();
+    check_unrolled<float, 8, 1, 8>();
+    check_unrolled<float, 4, 4, 4>();
+
+    SECTION("4x4 float layouts")
+    {
+        using cmat4 = la::fs_matrix<float, 4, 4, la::column_major>;
+        auto static CONSTEXPR a = mat<float, 4, 4>{1, 2, 3, 4,
+                                                   5, 6, 7, 8,
+                                                   -1, -2, -3, -4,
+                                                   0, 1, 0, 1};
+        auto static CONSTEXPR b = mat<float, 4, 4>{2, 0, 1, 0,
+                                                   0, 2, 0, 1,
+                                                   1, 1, 1, 1,
+                                                   3, -1, 2, -2};
+        auto static CONSTEXPR ab = a * b; // at compile time, by the scalar kernel
+        auto const expected = dmat<float>(a) * dmat<float>(b);
+        CHECK(ab == expected);
+
+        auto const ca = cmat4(a);
+        auto const cb = cmat4(b);
+        CHECK(a * b == expected);
+        CHECK(ca * cb == expected);
+        CHECK(a * cb == expected);
+        CHECK(ca * b == expected);
+        CHECK(a.t() * b.t() == dmat<float>(a).t() * dmat<float>(b).t());
+        CHECK(cb.t() * ca.t() == expected.t());
+    }
+}
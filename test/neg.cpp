@@ -33,3 +33,14 @@ TEST_CASE("negation: matrix")
     auto static CONSTEXPR m3 = imat<2, 2>{-1, 2, -3, 4};
     REQUIRE(m2 == m3);
 }
+
+TEST_CASE("negation: rvalue operand")
+{
+    auto m = dmat<double>(imat<2, 2>{1, -2, 3, -4});
+    auto const* const data = m.span().data();
+    auto const n = -std::move(m);
+    CHECK(n == imat<2, 2>{-1, 2, -3, 4});
+    CHECK(n.span().data() == data);
+
+    CHECK(-dvec<int>(ivec<3>{0, 1, 2}) == ivec<3>{0, -1, -2});
+}
@@ -0,0 +1,150 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <cmath>
+
+#include <catch2/catch.hpp>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+namespace execution = la::execution;
+
+TEMPLATE_TEST_CASE("simd.kernels", "", float, double, int)
+{
+    // odd sizes, to cover the scalar tail after the last full pack
+    for (std::size_t const n : {1u, 3u, 17u, 100u, 10'001u})
+    {
+        auto a = std::vector<TestType>(n);
+        auto b = std::vector<TestType>(n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            a[k] = TestType(int(k % 13) - 6);
+            b[k] = TestType(int(k % 7) - 3);
+        }
+
+        auto r = std::vector<TestType>(n);
+        auto const check = [&](auto f) {
+            for (std::size_t k = 0; k < n; ++k)
+                if (r[k] != f(k))
+                    return false;
+            return true;
+        };
+
+        la::detail::simd::add(execution::seq, n, a.data(), b.data(), r.data());
+        CHECK(check([&](auto k) { return TestType(a[k] + b[k]); }));
+
+        la::detail::simd::subtract(execution::par, n, a.data(), b.data(), r.data());
+        CHECK(check([&](auto k) { return TestType(a[k] - b[k]); }));
+
+        la::detail::simd::negate(execution::unseq, n, a.data(), r.data());
+        CHECK(check([&](auto k) { return TestType(-a[k]); }));
+
+        la::detail::simd::scale(execution::par, n, a.data(), TestType(3), r.data());
+        CHECK(check([&](auto k) { return TestType(a[k] * 3); }));
+    }
+}
+
+TEST_CASE("simd.negative_zero")
+{
+    auto const a = dvec<double>{0.0, -0.0, 1.0, 2.0, 3.0};
+    auto const r = -a;
+    CHECK(std::signbit(r(0)));
+    CHECK_FALSE(std::signbit(r(1)));
+}
+
+TEST_CASE("simd.operations")
+{
+    auto const a = dmat<double>(37, 41, [](auto i, auto j) { return double(i * 3 + j) * 0.25; });
+    auto const b = dmat<double>(37, 41, [](auto i, auto j) { return double(i) - double(j); });
+
+    auto const expect = [](auto const& m, auto f) {
+        for (std::size_t i = 0; i < m.rows(); ++i)
+            for (std::size_t j = 0; j < m.columns(); ++j)
+                if (m(i, j) != f(i, j))
+                    return false;
+        return true;
+    };
+
+    CHECK(expect(a + b, [&](auto i, auto j) { return a(i, j) + b(i, j); }));
+    CHECK(expect(a - b, [&](auto i, auto j) { return a(i, j) - b(i, j); }));
+    CHECK(expect(-a, [&](auto i, auto j) { return -a(i, j); }));
+    CHECK(expect(a * 2.0, [&](auto i, auto j) { return a(i, j) * 2.0; }));
+    CHECK(expect(2.0 * a, [&](auto i, auto j) { return 2.0 * a(i, j); }));
+
+    SECTION("padded storage falls back to the element loop") {
+        auto c = b;
+        c.reserve(40, 48);
+        REQUIRE_FALSE(c.span().is_contiguous());
+        CHECK(a + c == a + b);
+        CHECK(-c == -b);
+    }
+
+    SECTION("mixed layouts") {
+        auto const at = dmat<double>(a.t());
+        CHECK(expect(b + at.t(), [&](auto i, auto j) { return a(i, j) + b(i, j); }));
+    }
+
+    SECTION("fixed-size") {
+        auto const f = mat<float, 3, 3>{1, 2, 3, 4, 5, 6, 7, 8, 9};
+        CHECK(f + f == 2.0f * f);
+        CHECK(f - f == mat<float, 3, 3>{});
+    }
+}
+
+TEST_CASE("simd.dot")
+{
+    // reference implementation of the documented summation order (for a single block)
+    auto const reference = [](auto const& a, auto const& b) {
+        using T = std::decay_t<decltype(a[0])>;
+        T lanes[16] = {};
+        for (std::size_t k = 0; k < a.size(); ++k)
+            lanes[k % 16] = lanes[k % 16] + a[k] * b[k];
+        for (std::size_t w = 8; w > 0; w /= 2)
+            for (std::size_t l = 0; l < w; ++l)
+                lanes[l] = lanes[l] + lanes[l + w];
+        return lanes[0];
+    };
+
+    for (std::size_t const n : {0u, 1u, 15u, 16u, 17u, 256u, 4099u})
+    {
+        auto a = dvec<float>(n);
+        auto b = dvec<float>(n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            a(k) = 1.0f / float(k + 1);
+            b(k) = float(k % 10) * 0.1f - 0.45f;
+        }
+
+        auto const as = std::vector<float>(a.engine().begin(), a.engine().end());
+        auto const bs = std::vector<float>(b.engine().begin(), b.engine().end());
+        CHECK(a * b == reference(as, bs));
+        CHECK(la::multiply(execution::par, a, b) == a * b);
+    }
+
+    SECTION("reproducible across policies") {
+        auto const n = 3 * la::detail::simd::dot_block_size + 123;
+        auto a = dvec<double>(n);
+        for (std::size_t k = 0; k < n; ++k)
+            a(k) = std::sin(double(k));
+        CHECK(la::multiply(execution::par, a, a) == la::multiply(execution::seq, a, a));
+        CHECK(a * a == Approx(double(n) / 2).epsilon(1e-3));
+    }
+
+    SECTION("integral") {
+        auto const v = dvec<long>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18};
+        CHECK(v * v == 2109);
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ * This file is part of the "dim" project
+ *   Copyright (c) 2020 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linear_algebra>
+#include "support.h"
+
+#include <cstring>
+
+#include <catch2/catch.hpp>
+
+namespace la = LINEAR_ALGEBRA_NAMESPACE;
+
+TEST_CASE("span.fs")
+{
+    auto static CONSTEXPR m = imat<2, 3>{1, 2, 3,
+                                         4, 5, 6};
+    auto CONSTEXPR s = m.span();
+    static_assert(std::is_same_v<decltype(s), la::matrix_span<int const> const>);
+    CHECK(s.data() == &m(0, 0));
+    CHECK(s.row_stride() == 3);
+    CHECK(s.column_stride() == 1);
+    CHECK(s.is_contiguous());
+    CHECK(s(1, 2) == 6);
+    CHECK(s.row(1)(0) == 4);
+    CHECK(s.column(2)(1) == 6);
+    CHECK(s.subspan(0, 2, 1, 2)(1, 0) == 5);
+    CHECK_FALSE(s.subspan(0, 2, 1, 2).is_contiguous());
+
+    auto const v = vec<int, 3>{7, 8, 9};
+    CHECK(v.span().size() == 3);
+    CHECK(v.span()(2) == 9);
+}
+
+TEST_CASE("span.dr")
+{
+    auto m = dmat<double>(2, 3);
+    m.reserve(4, 5);
+    m(1, 2) = 42;
+    auto const s = m.span();
+    static_assert(std::is_same_v<decltype(s), la::matrix_span<double> const>);
+    CHECK(s.rows() == 2);
+    CHECK(s.columns() == 3);
+    CHECK(s.leading_dimension() == 5);
+    CHECK_FALSE(s.is_contiguous());
+    CHECK(s.data() + 1 * 5 + 2 == &m(1, 2));
+
+    s(0, 1) = 7; // writes through
+    CHECK(m(0, 1) == 7);
+
+    // copy via the raw storage
+    auto v = dvec<double>{1, 2, 3};
+    auto w = dvec<double>(3);
+    std::memcpy(w.engine().data(), v.engine().data(), 3 * sizeof(double));
+    CHECK(w == v);
+}
+
+TEST_CASE("span.views")
+{
+    auto m = imat<2, 3>{1, 2, 3,
+                        4, 5, 6};
+
+    SECTION("transpose") {
+        auto const s = m.t().span();
+        CHECK(s.rows() == 3);
+        CHECK(s.columns() == 2);
+        CHECK(s.is_column_major());
+        CHECK(s.leading_dimension() == 3);
+        CHECK(s(2, 1) == 6);
+        s(2, 0) = 30;
+        CHECK(m(0, 2) == 30);
+
+        auto const& cm = m;
+        static_assert(std::is_same_v<decltype(cm.t().span()), la::matrix_span<int const>>);
+    }
+
+    SECTION("row and column") {
+        CHECK(m.row(1).span()(2) == 6);
+        CHECK(m.row(1).span().is_contiguous());
+        CHECK(m.column(1).span().stride() == 3);
+        CHECK(m.column(1).span()(1) == 5);
+    }
+
+    static_assert(la::has_span_v<la::dr_matrix_engine<int>>);
+    static_assert(!la::has_span_v<decltype(m.submatrix(0, 0))::engine_type>);
+    static_assert(!la::has_span_v<la::csr_matrix_engine<int>>);
+}
@@ -16,6 +16,8 @@
 #include <linear_algebra>
 #include "support.h"
 
+#include <complex>
+
 #include <catch2/catch.hpp>
 
 TEST_CASE("subtraction: vector - vector")
@@ -35,3 +37,70 @@ TEST_CASE("subtraction: matrix - matrix")
     auto static CONSTEXPR expected = imat<2, 2>{5, 0, -3, -8};
     REQUIRE(m3 == expected);
 }
+
+TEST_CASE("subtraction: in place")
+{
+    auto static CONSTEXPR v = [] {
+        auto v1 = ivec<3>{3, 4, 5};
+        v1 -= ivec<3>{0, 1, 2};
+        return v1;
+    }();
+    REQUIRE(v == ivec<3>{3, 3, 3});
+
+    auto m = dmat<double>(imat<2, 2>{1, 2,
+                                     3, 4});
+    m -= m.t();
+    CHECK(m == imat<2, 2>{0, -1,
+                          1, 0});
+
+    m.row(1) -= dvec<double>(ivec<2>{1, 1});
+    CHECK(m == imat<2, 2>{0, -1,
+                          0, -1});
+
+    // without SIMD kernels, i.e. updated element by element
+    using complex = std::complex<double>;
+    auto c = dmat<complex>(3, 3, [](auto i, auto j) { return complex(double(i * 3 + j + 1), double(j)); });
+    c -= c.t();
+    CHECK(c == dmat<complex>(3, 3, [](auto i, auto j) { return complex(double(i * 3 + j) - double(j * 3 + i), double(j) - double(i)); }));
+
+    auto e = dmat<complex>(imat<2, 2>{1, 2,
+                                      3, 4});
+    CHECK(std::move(e) - e.t() == dmat<complex>(imat<2, 2>{0, -1,
+                                                           1,  0}));
+
+    constexpr auto f = [] {
+        auto f = imat<3, 3>{1, 2, 3,
+                            4, 5, 6,
+                            7, 8, 9};
+        f -= f.t();
+        return f;
+    }();
+    static_assert(f == imat<3, 3>{0, -2, -4,
+                                  2,  0, -2,
+                                  4,  2,  0});
+}
+
+TEST_CASE("subtraction: rvalue operands")
+{
+    auto const a = dmat<double>(imat<2, 3>{1, 2, 3,
+                                           4, 5, 6});
+
+    auto b = dmat<double>(imat<2, 3>{6, 5, 4,
+                                     3, 2, 1});
+    auto const* const data = b.span().data();
+    auto const r1 = a - std::move(b);
+    CHECK(r1 == imat<2, 3>{-5, -3, -1,
+                            1,  3,  5});
+    CHECK(r1.span().data() == data);
+
+    auto const r2 = (a - r1) - a.t().t();
+    CHECK(r2 == -r1);
+
+    // padded, i.e. updated row by row
+    auto p = dmat<double>(2, 3, 4, 8);
+    p = a;
+    CHECK(a - std::move(p) == imat<2, 3>{0, 0, 0, 0, 0, 0});
+
+    auto v = dvec<double>(ivec<3>{3, 4, 5});
+    CHECK(ivec<3>{1, 1, 1} - std::move(v) == ivec<3>{-2, -3, -4});
+}